@@ -0,0 +1,38 @@
+# build_id.cmake
+#
+# Writes the build id of the run cache (include/io/run_cache.h) to
+# BUILD_ID_HEADER. Runs as a script on every build, so the id follows the
+# installed Shark library without a new configure run. The sources of this
+# repository are left out: changes to them that change results bump
+# RESULTS_VERSION in src/io/run_cache.cpp instead. The header is only
+# rewritten when the id changes, so run_cache.cpp is only recompiled then.
+#
+# Inputs (-D):
+#   SHARK_LIBRARY_DIRS  directories of the Shark library, separated by |
+#   BUILD_ID_PREFIX     Shark version, compiler, build type, options hash
+#   BUILD_ID_HEADER     header to write
+
+# installed Shark library
+string(REPLACE "|" ";" SHARK_LIBRARY_DIRS "${SHARK_LIBRARY_DIRS}")
+set(SHARK_LIBRARY_HASHES "")
+foreach(SHARK_LIBRARY_DIR ${SHARK_LIBRARY_DIRS})
+  file(GLOB SHARK_LIBRARY_FILES "${SHARK_LIBRARY_DIR}/*shark*")
+  list(SORT SHARK_LIBRARY_FILES)
+  foreach(SHARK_LIBRARY_FILE ${SHARK_LIBRARY_FILES})
+    file(SHA256 ${SHARK_LIBRARY_FILE} SHARK_LIBRARY_FILE_HASH)
+    string(APPEND SHARK_LIBRARY_HASHES ${SHARK_LIBRARY_FILE_HASH})
+  endforeach()
+endforeach()
+string(SHA256 SHARK_LIBRARY_HASH "${SHARK_LIBRARY_HASHES}")
+string(SUBSTRING ${SHARK_LIBRARY_HASH} 0 16 SHARK_LIBRARY_HASH)
+
+set(BUILD_ID "${BUILD_ID_PREFIX}-${SHARK_LIBRARY_HASH}")
+set(CONTENT "// generated by cmake/build_id.cmake\n#define EXPERIMENTS_BUILD_ID \"${BUILD_ID}\"\n")
+set(PREVIOUS "")
+if(EXISTS ${BUILD_ID_HEADER})
+  file(READ ${BUILD_ID_HEADER} PREVIOUS)
+endif()
+if(NOT PREVIOUS STREQUAL CONTENT)
+  file(WRITE ${BUILD_ID_HEADER} "${CONTENT}")
+  message(STATUS "Run cache build id: ${BUILD_ID}")
+endif()
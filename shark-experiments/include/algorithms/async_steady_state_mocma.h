@@ -0,0 +1,142 @@
+/* async_steady_state_mocma.h
+ *
+ * DESCRIPTION
+ * Asynchronous (mu+1)-MO-CMA-ES for two objectives and expensive objective
+ * functions. It keeps parallelism() offspring in flight on an
+ * AsyncEvaluator and integrates each one as soon as its evaluation
+ * finishes. Selection is that of IncrementalSteadyStateMOCMA: the offspring
+ * joins the IncrementalFront2D and the least contributor of the worst
+ * front leaves. Then a new offspring of the current population is sent out.
+ * One step() integrates one finished evaluation, so budget checks on the
+ * evaluation counter work as for the sequential variant. The counter
+ * includes evaluations that are running, so it can be ahead of the
+ * integrated offspring by up to parallelism() - 1. With parallelism() == 1
+ * the algorithm is IncrementalSteadyStateMOCMA.
+ *
+ * Stale parents: an offspring is created from a copy of its parent's
+ * strategy parameters and point, and the copy is what it inherits when it
+ * is integrated, however many siblings were integrated in the meantime. If
+ * the parent is still in the population when the offspring comes back, its
+ * step size is updated with the offspring's success as usual. If it has been
+ * removed in the meantime, the update is dropped. With the individual
+ * based notion of success the offspring then counts as successful if it
+ * survives.
+ *
+ * Box constraints are handled when an offspring is created: an infeasible
+ * point is evaluated at its closest feasible point and the quadratic
+ * penalty is added when the value comes back.
+ *
+ * Runs are reproducible only for parallelism() == 1, because the order in
+ * which evaluations finish decides the order of integration.
+ *
+ * REFERENCES
+ * - C. Igel, T. Suttorp and N. Hansen. Steady-state Selection and Efficient
+ *   Covariance Matrix Update in the Multi-objective CMA-ES. EMO 2007.
+ */
+#pragma once
+
+#include <shark/Algorithms/AbstractMultiObjectiveOptimizer.h>
+#include <shark/LinAlg/Base.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "algorithms/incremental_front.h"
+#include "algorithms/mocma_chromosome.h"
+#include "algorithms/philox.h"
+#include "algorithms/population_store.h"
+#include "parallel/async_evaluator.h"
+
+class AsyncSteadyStateMOCMA : public shark::AbstractMultiObjectiveOptimizer<shark::RealVector> {
+   public:
+    enum class NotionOfSuccess { IndividualBased, PopulationBased };
+
+    // mirrors indicator().setReference() of Shark's SteadyStateMOCMA
+    struct Indicator {
+        // empty: the worst point of every front plus one
+        shark::RealVector reference;
+        void setReference(shark::RealVector const& point) { reference = point; }
+    };
+
+    AsyncSteadyStateMOCMA();
+    ~AsyncSteadyStateMOCMA();
+
+    std::string name() const override { return "AsyncSteadyStateMOCMA"; }
+
+    std::size_t mu() const { return m_mu; }
+    std::size_t& mu() { return m_mu; }
+    double initialSigma() const { return m_initialSigma; }
+    double& initialSigma() { return m_initialSigma; }
+    NotionOfSuccess notionOfSuccess() const { return m_notionOfSuccess; }
+    NotionOfSuccess& notionOfSuccess() { return m_notionOfSuccess; }
+    Indicator& indicator() { return m_indicator; }
+    // offspring in flight
+    std::size_t parallelism() const { return m_parallelism; }
+    std::size_t& parallelism() { return m_parallelism; }
+    // evaluation threads, 0 means one per offspring in flight
+    std::size_t workers() const { return m_workers; }
+    std::size_t& workers() { return m_workers; }
+
+    // the evaluator of the current run, for its busy and wait times
+    AsyncEvaluator const& evaluator() const { return *m_evaluator; }
+
+    void init(ObjectiveFunctionType const& function) override;
+    void init(ObjectiveFunctionType const& function, std::vector<SearchPointType> const& initialSearchPoints) override;
+    // waits for one offspring, integrates it and sends out the next one;
+    // function has to be the one passed to init()
+    void step(ObjectiveFunctionType const& function) override;
+
+   private:
+    // strategy parameters of row i of m_store
+    struct Individual {
+        MOCMAChromosome chromosome;
+        // handle in m_front
+        std::size_t handle = 0;
+        // entry in m_best
+        std::size_t solution = 0;
+        // unique per individual, 0 for a free slot
+        std::uint64_t birth = 0;
+        // for offspring in flight: slot and birth of the parent at creation
+        std::size_t parent = 0;
+        std::uint64_t parentBirth = 0;
+        // squared distance to the evaluated feasible point
+        double penalty = 0.0;
+    };
+
+    // creates an offspring in a free slot and submits it
+    void submit(ObjectiveFunctionType const& function);
+    // selection with the finished offspring in slot
+    void integrate(std::size_t slot, shark::RealVector const& value);
+    // point of slot or its closest feasible point, sets the penalty
+    shark::RealVector const& evaluationPoint(ObjectiveFunctionType const& function, std::size_t slot);
+
+    std::size_t m_mu;
+    double m_initialSigma;
+    NotionOfSuccess m_notionOfSuccess;
+    Indicator m_indicator;
+    std::size_t m_parallelism;
+    std::size_t m_workers;
+    double m_penaltyFactor;
+    MOCMAConstants m_constants;
+
+    // mu + parallelism slots: the population, the offspring in flight, and
+    // between integrating and submitting one free slot
+    PopulationStore m_store;
+    std::vector<Individual> m_individuals;
+    std::vector<std::size_t> m_free;
+    std::uint64_t m_births;
+    // front handle to slot
+    std::vector<std::size_t> m_slots;
+    IncrementalFront2D m_front;
+    Philox m_rng;
+    ObjectiveFunctionType const* m_function;
+    std::unique_ptr<AsyncEvaluator> m_evaluator;
+    // scratch vectors for the objective function interface
+    shark::RealVector m_z;
+    shark::RealVector m_point;
+    shark::RealVector m_feasible;
+    shark::RealVector m_penalizedValue;
+};
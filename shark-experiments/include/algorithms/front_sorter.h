@@ -0,0 +1,93 @@
+/* front_sorter.h
+ *
+ * DESCRIPTION
+ * Non-dominated sorting for large populations. Assigns every point the
+ * index of its front (1 = non-dominated), with the same calling convention
+ * as shark::nonDominatedSort(points, ranks), so it can replace it in
+ * selection operators.
+ *
+ * Two objectives are sorted by a single sweep in O(N log N). For k > 2
+ * objectives the divide-and-conquer scheme of Jensen, in the corrected form
+ * of Buzdalov and Shalyto, needs O(N log^(k-1) N). Small subproblems are
+ * finished by brute force over objective-major copies of the values, which
+ * the compiler turns into vectorised dominance checks. Scratch memory,
+ * including the index lists of the recursion and the staircase nodes, is
+ * kept between calls.
+ *
+ * REFERENCES
+ * - M. T. Jensen. Reducing the Run-time Complexity of Multiobjective EAs:
+ *   The NSGA-II and Other Algorithms. IEEE TEC 7(5), 2003.
+ * - M. Buzdalov and A. Shalyto. A Provably Asymptotically Fast Version of
+ *   the Generalized Jensen Algorithm for Non-dominated Sorting. PPSN 2014.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "algorithms/object_pool.h"
+
+class FrontSorter {
+   public:
+    // ranks must have as many elements as points
+    template <class PointRange, class RankRange>
+    void operator()(PointRange const& points, RankRange& ranks) {
+        std::size_t size = ranks.size();
+        if (size == 0) return;
+        std::size_t objectives = (*points.begin()).size();
+        m_input.resize(size * objectives);
+        std::size_t i = 0;
+        for (auto const& point : points) {
+            for (std::size_t j = 0; j != objectives; j++) m_input[i * objectives + j] = point[j];
+            i++;
+        }
+        sort(m_input.data(), size, objectives, m_output);
+        i = 0;
+        for (auto& rank : ranks) rank = m_output[i++];
+    }
+
+    // values is row-major, size x objectives
+    void sort(double const* values, std::size_t size, std::size_t objectives, std::vector<unsigned int>& ranks);
+
+   private:
+    typedef std::vector<std::size_t> Indices;
+
+    // an empty index list from m_indices
+    ObjectPool<Indices>::Lease indices() {
+        auto ret = m_indices.acquire();
+        ret->clear();
+        return ret;
+    }
+
+    double value(std::size_t point, std::size_t objective) const { return m_values[point * m_objectives + objective]; }
+    double median(Indices const& points, std::size_t objective);
+
+    void sweep2D();
+    void helperA(Indices const& points, std::size_t objective);
+    void helperB(Indices const& lower, Indices const& higher, std::size_t objective);
+    void sweepA(Indices const& points);
+    void sweepB(Indices const& lower, Indices const& higher);
+    void bruteA(Indices const& points, std::size_t objective);
+    void bruteB(Indices const& lower, Indices const& higher, std::size_t objective);
+
+    // distinct points in lexicographic order, row-major
+    std::vector<double> m_values;
+    std::size_t m_objectives = 0;
+    // 0 based front of every distinct point
+    std::vector<unsigned int> m_rank;
+    // smallest objective 1 value of every front in sweep2D
+    std::vector<double> m_frontMinima;
+
+    std::vector<std::size_t> m_order;
+    std::vector<std::size_t> m_distinct;
+    std::vector<double> m_input;
+    std::vector<unsigned int> m_output;
+    std::vector<double> m_medians;
+    // objective-major gather of the lower set in bruteB
+    std::vector<double> m_columns;
+    std::vector<unsigned int> m_columnRanks;
+    std::vector<unsigned char> m_mask;
+    ObjectPool<Indices> m_indices;
+    std::shared_ptr<NodeArena> m_arena = std::make_shared<NodeArena>();
+};
@@ -0,0 +1,111 @@
+/* front_sorting_nsga2.h
+ *
+ * DESCRIPTION
+ * Shark's real-coded NSGA-II (RealCodedNSGAII or one of the
+ * IndicatorBasedRealCodedNSGAII variants) with the non-dominated sorting of
+ * its environmental selection done by FrontSorter instead of
+ * shark::nonDominatedSort. Variation is Shark's own generateOffspring();
+ * the selection repeats Shark's IndicatorBasedSelection step by step: the
+ * fronts are taken whole in rank order, and the indicator removes the least
+ * contributors of the last front, with the better fronts as archive. The
+ * ranks are the same as those of Shark, and every front is handed to the
+ * indicator in population order, so the optimizer takes the same steps as
+ * the one it derives from, only faster for large populations.
+ *
+ * Shark keeps the parents (m_parents), the solution (m_best) and
+ * generateOffspring() protected for derived algorithms, as used by Island
+ * in algorithms/island_model.h.
+ *
+ * REFERENCES
+ * - K. Deb, A. Pratap, S. Agarwal and T. Meyarivan. A Fast and Elitist
+ *   Multiobjective Genetic Algorithm: NSGA-II. IEEE TEC 6(2), 2002.
+ */
+#pragma once
+
+#include <shark/Algorithms/DirectSearch/Operators/Evaluation/PenalizingEvaluator.h>
+#include <shark/LinAlg/Base.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "algorithms/front_sorter.h"
+
+template <typename NSGAII>
+class FrontSortingNSGAII : public NSGAII {
+   public:
+    typedef typename NSGAII::IndividualType IndividualType;
+    typedef typename NSGAII::ObjectiveFunctionType ObjectiveFunctionType;
+
+    using NSGAII::NSGAII;
+
+    void step(ObjectiveFunctionType const& function) override {
+        std::vector<IndividualType> offspring = this->generateOffspring();
+        shark::PenalizingEvaluator penalizingEvaluator;
+        penalizingEvaluator(function, offspring.begin(), offspring.end());
+
+        auto& parents = this->m_parents;
+        std::size_t mu = this->mu();
+        parents.insert(parents.end(), offspring.begin(), offspring.end());
+        select(mu);
+        std::partition(parents.begin(), parents.end(), IndividualType::IsSelected);
+        parents.erase(parents.begin() + mu, parents.end());
+
+        this->m_best.resize(mu);
+        for (std::size_t i = 0; i != mu; i++) {
+            this->m_best[i].point = parents[i].searchPoint();
+            this->m_best[i].value = parents[i].unpenalizedFitness();
+        }
+    }
+
+   private:
+    // marks the mu survivors of the parents as selected
+    void select(std::size_t mu) {
+        auto& parents = this->m_parents;
+        std::size_t size = parents.size();
+        if (size == 0) return;
+
+        std::size_t objectives = parents[0].penalizedFitness().size();
+        m_values.resize(size * objectives);
+        for (std::size_t i = 0; i != size; i++) {
+            std::copy(parents[i].penalizedFitness().begin(), parents[i].penalizedFitness().end(), m_values.begin() + i * objectives);
+        }
+        m_sorter.sort(m_values.data(), size, objectives, m_ranks);
+
+        // members of every front in population order
+        unsigned int maxRank = *std::max_element(m_ranks.begin(), m_ranks.end());
+        m_fronts.resize(maxRank + 1);
+        for (auto& front : m_fronts) front.clear();
+        for (std::size_t i = 0; i != size; i++) {
+            parents[i].rank() = m_ranks[i];
+            parents[i].selected() = true;
+            m_fronts[m_ranks[i]].push_back(i);
+        }
+
+        // drop whole fronts while the rest still has mu members
+        unsigned int rank = maxRank;
+        std::size_t popSize = size;
+        while (popSize - m_fronts[rank].size() >= mu) {
+            for (std::size_t i : m_fronts[rank]) parents[i].selected() = false;
+            popSize -= m_fronts[rank].size();
+            rank--;
+        }
+        if (popSize == mu) return;
+
+        // the last front loses its least contributors against the better fronts
+        std::vector<shark::RealVector> front, archive;
+        for (std::size_t i : m_fronts[rank]) front.push_back(parents[i].penalizedFitness());
+        for (unsigned int r = 1; r != rank; r++) {
+            for (std::size_t i : m_fronts[r]) archive.push_back(parents[i].penalizedFitness());
+        }
+        for (std::size_t lc : this->indicator().leastContributors(front, archive, popSize - mu)) {
+            parents[m_fronts[rank][lc]].selected() = false;
+        }
+    }
+
+    FrontSorter m_sorter;
+    std::vector<double> m_values;
+    std::vector<unsigned int> m_ranks;
+    // indices of the members of every front, by rank
+    std::vector<std::vector<std::size_t>> m_fronts;
+};
@@ -0,0 +1,122 @@
+/* incremental_front.h
+ *
+ * DESCRIPTION
+ * Population of bi-objective points kept sorted into non-dominated fronts
+ * under single insertions and deletions, for steady-state selection. Every
+ * front is a search tree in objective 0 order (objective 1 decreases along
+ * it), so
+ *   - the front of a new point is found by binary search over the fronts,
+ *     each probe looking at one neighbour: O(log^2 mu);
+ *   - the points a new point pushes down (or a removed point releases) are
+ *     contiguous in their front, and only they and their neighbours change;
+ *   - hypervolume contributions only depend on the two neighbours within
+ *     the front and are kept in an ordered index per front.
+ * An insertion or deletion costs O(log^2 mu) plus O(log mu) per point that
+ * changes its front. Removing a point of the worst front, the steady-state
+ * case, never moves other points.
+ *
+ * Without a reference point every front uses its worst point plus one in
+ * each objective, as Shark's HypervolumeIndicator does, so the extreme
+ * points of a front have a finite contribution too.
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "algorithms/object_pool.h"
+
+class IncrementalFront2D {
+   public:
+    IncrementalFront2D();
+
+    // reference point of the contributions, recomputes all of them
+    void setReference(double reference0, double reference1);
+    void clearReference();
+
+    // returns a handle that stays valid until the point is erased
+    std::size_t insert(double value0, double value1);
+    void erase(std::size_t handle);
+    void clear();
+
+    std::size_t size() const { return m_size; }
+    std::size_t numberOfFronts() const { return m_fronts.size(); }
+    // 1 = non-dominated
+    std::size_t rank(std::size_t handle) const { return m_nodes[handle].front + 1; }
+    double contribution(std::size_t handle) const { return m_nodes[handle].contribution; }
+    double value(std::size_t handle, std::size_t objective) const { return objective == 0 ? m_nodes[handle].key.value0 : m_nodes[handle].key.value1; }
+
+    // handles of front r (0 based) in objective 0 order
+    std::vector<std::size_t> front(std::size_t r) const;
+    std::size_t frontSize(std::size_t r) const { return m_fronts[r].points.size(); }
+    // i-th point of front r in objective 0 order, O(i)
+    std::size_t nth(std::size_t r, std::size_t i) const;
+
+    // least hypervolume contributor of the worst front
+    std::size_t leastContributor() const;
+
+   private:
+    struct Key {
+        double value0;
+        double value1;
+        std::size_t handle;
+        bool operator<(Key const& other) const {
+            if (value0 != other.value0) return value0 < other.value0;
+            if (value1 != other.value1) return value1 < other.value1;
+            return handle < other.handle;
+        }
+    };
+
+    typedef std::pair<double, std::size_t> Contribution;
+
+    // tree nodes are recycled through the arena of the population
+    struct Front {
+        explicit Front(std::shared_ptr<NodeArena> const& arena)
+            : points(std::less<Key>(), PoolAllocator<Key>(arena)), contributions(std::less<Contribution>(), PoolAllocator<Contribution>(arena)) {}
+
+        std::set<Key, std::less<Key>, PoolAllocator<Key>> points;
+        // (contribution, handle)
+        std::set<Contribution, std::less<Contribution>, PoolAllocator<Contribution>> contributions;
+    };
+    typedef std::set<Key, std::less<Key>, PoolAllocator<Key>>::iterator KeyIterator;
+
+    struct Node {
+        Key key;
+        std::size_t front;
+        double contribution;
+        bool used;
+    };
+
+    bool dominatedBy(Front const& front, Key const& key) const;
+    // appends the points of the front dominated by any of keys, which must be
+    // mutually non-dominated and in objective 0 order, once each and in
+    // objective 0 order
+    void dominatedIn(Front const& front, std::vector<Key> const& keys, std::vector<Key>& out) const;
+
+    void attach(std::size_t r, Key const& key);
+    void detach(Key const& key);
+    void refresh(Front& front, KeyIterator it);
+    void refreshAround(Front& front, Key const& key);
+
+    // move the points of front r dominated by m_current one front down
+    void pushDown(std::size_t r);
+    // move the points of front r + 1 dominated by m_current up, if possible
+    void pullUp(std::size_t r);
+
+    std::shared_ptr<NodeArena> m_arena;
+    std::vector<Node> m_nodes;
+    std::vector<std::size_t> m_free;
+    std::vector<Front> m_fronts;
+    std::size_t m_size;
+    bool m_hasReference;
+    double m_reference0;
+    double m_reference1;
+    // points moving between fronts
+    std::vector<Key> m_current;
+    std::vector<Key> m_next;
+};
@@ -0,0 +1,135 @@
+/* island_model.h
+ *
+ * DESCRIPTION
+ * Island model for Shark's multi-objective optimizers: several instances of
+ * the same optimizer (MOCMA, SMSEMOA or RealCodedNSGAII) evolve their own
+ * populations on separate threads against one objective function, and
+ * every interval() generations each island sends copies of up to
+ * migrants() members of its first front to other islands. A generation is
+ * mu evaluations of the island, so that the steady-state SMS-EMOA migrates
+ * as often as the generational algorithms. Topology::Ring sends to the next
+ * island, Topology::FullyConnected to all others and Topology::Random to
+ * one other island drawn anew every time.
+ *
+ * Every island has a lock-free MPSCQueue as its mailbox. Senders never wait
+ * for the receiver; the receiver empties its mailbox when it migrates
+ * itself, and the arrivals replace the members of its worst fronts. They
+ * keep their strategy parameters (the step size and covariance of the
+ * MO-CMA-ES), so islands must run the same optimizer on the same problem.
+ *
+ * Each island draws from its own random number generator, seeded from
+ * shark::random::globalRng() in run(), and evaluates through its own
+ * counting wrapper of the function, which must be thread safe (MOBenchmark
+ * is). The arrival of migrants depends on the thread schedule, so runs
+ * with more than one island are not reproducible.
+ *
+ * With a ParetoArchive2D set, the islands also add their solutions to it,
+ * so the archive can be snapshotted while they run.
+ *
+ * REFERENCES
+ * - E. Cantu-Paz. A Survey of Parallel Genetic Algorithms. Calculateurs
+ *   Paralleles, Reseaux et Systems Repartis 10(2), 1998.
+ * - D. Izzo, M. Rucinski and F. Biscani. The Generalized Island Model.
+ *   Parallel Architectures and Bioinspired Algorithms, Springer 2012.
+ */
+#pragma once
+
+#include <shark/Core/Random.h>
+#include <shark/LinAlg/Base.h>
+#include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "parallel/mpsc_queue.h"
+#include "parallel/pareto_archive.h"
+#include "parallel/sharded_counter.h"
+
+// Shark optimizer with access to its population; Shark keeps the parents
+// (m_parents) and their type protected for derived algorithms
+template <typename Optimizer>
+class Island : public Optimizer {
+   public:
+    typedef typename Optimizer::IndividualType IndividualType;
+
+    // rng must outlive the island
+    explicit Island(shark::random::rng_type& rng) : Optimizer(rng) {}
+
+    // copies of up to count members of the first front, evenly spread over
+    // the front ordered by the first objective
+    void emigrants(std::size_t count, std::vector<IndividualType>& migrants) const;
+    // overwrites the parents of the worst fronts, at most all of them
+    void immigrate(std::vector<IndividualType> const& migrants);
+};
+
+template <typename Optimizer>
+class IslandModel {
+   public:
+    enum class Topology { Ring, FullyConnected, Random };
+
+    typedef Island<Optimizer> IslandType;
+    typedef typename IslandType::IndividualType IndividualType;
+    typedef typename Optimizer::SolutionType SolutionType;
+
+    // configure is called for every island, e.g. to set mu() and
+    // initialSigma(); islands counts the calling thread
+    IslandModel(std::size_t islands, std::function<void(Optimizer&)> const& configure);
+    ~IslandModel();
+
+    std::size_t islands() const { return m_islands.size(); }
+    Topology topology() const { return m_topology; }
+    Topology& topology() { return m_topology; }
+    // generations between migrations
+    std::size_t interval() const { return m_interval; }
+    std::size_t& interval() { return m_interval; }
+    // individuals per migration and destination
+    std::size_t migrants() const { return m_migrants; }
+    std::size_t& migrants() { return m_migrants; }
+
+    IslandType const& island(std::size_t i) const { return *m_islands[i]->optimizer; }
+
+    // shared archive that every island feeds its solution at each migration
+    // and when it is done, nullptr for none; must outlive run()
+    void setArchive(ParetoArchive2D* archive) { m_archive = archive; }
+
+    // initialises all islands and evolves them until they have used budget
+    // evaluations in total, split evenly; returns when all are done
+    void run(shark::MultiObjectiveFunction const& function, std::size_t budget);
+
+    // non-dominated members of the solutions of all islands
+    SolutionType const& solution() const { return m_solution; }
+    // individuals sent and received over all islands in the last run
+    std::size_t sent() const { return m_sent.value(); }
+    std::size_t received() const { return m_received.value(); }
+
+   private:
+    class Objective;
+
+    struct Message {
+        std::vector<IndividualType> individuals;
+    };
+
+    struct Node {
+        shark::random::rng_type rng;
+        std::unique_ptr<IslandType> optimizer;
+        std::unique_ptr<Objective> function;
+        MPSCQueue<Message> mailbox;
+        // scratch for the individuals of one migration
+        std::vector<IndividualType> migrants;
+    };
+
+    void evolve(std::size_t i, std::size_t budget);
+    void migrate(std::size_t i);
+    void updateSolution();
+
+    std::vector<std::unique_ptr<Node>> m_islands;
+    Topology m_topology;
+    std::size_t m_interval;
+    std::size_t m_migrants;
+    SolutionType m_solution;
+    ParetoArchive2D* m_archive;
+    ShardedCounter m_sent;
+    ShardedCounter m_received;
+};
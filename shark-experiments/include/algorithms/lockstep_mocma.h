@@ -0,0 +1,104 @@
+/* lockstep_mocma.h
+ *
+ * DESCRIPTION
+ * Lanes independent (mu+mu)-MO-CMA-ES runs on the lanes of an
+ * MOBenchmarkLanes, advanced in lockstep. Every run has its own instance,
+ * random stream and population; the populations are stored interleaved
+ * across the runs like the benchmark data, so mutation (triangular
+ * matrix-vector products), evaluation and the step size and Cholesky
+ * factor updates execute as one vectorised loop over the runs. Only
+ * selection, which branches differently in every run, is done per lane.
+ *
+ * The algorithm is that of ParallelMOCMA: offspring i is created from
+ * parent i, box constraints are handled by evaluating the closest feasible
+ * point with a quadratic penalty, and the last front is reduced by
+ * removing least hypervolume contributors with the worst value of the
+ * front plus one as reference. All runs start from the origin, as
+ * MOBenchmark::proposeStartingPoint() does.
+ *
+ * REFERENCES
+ * - C. Igel, N. Hansen and S. Roth. Covariance Matrix Adaptation for
+ *   Multi-objective Optimization. Evolutionary Computation 15(1), 2007.
+ * - T. Voss, N. Hansen and C. Igel. Improved Step Size Adaptation for the
+ *   MO-CMA-ES. GECCO 2010.
+ */
+#pragma once
+
+#include <shark/LinAlg/Base.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "algorithms/front_sorter.h"
+#include "algorithms/mocma_chromosome.h"
+#include "moq/benchmark_lanes.h"
+
+template <std::size_t Lanes>
+class LockstepMOCMA {
+   public:
+    enum class NotionOfSuccess { IndividualBased, PopulationBased };
+
+    LockstepMOCMA();
+
+    std::size_t mu() const { return m_mu; }
+    std::size_t& mu() { return m_mu; }
+    double initialSigma() const { return m_initialSigma; }
+    double& initialSigma() { return m_initialSigma; }
+    NotionOfSuccess notionOfSuccess() const { return m_notionOfSuccess; }
+    NotionOfSuccess& notionOfSuccess() { return m_notionOfSuccess; }
+
+    // seeds the runs from shark::random::globalRng()
+    void init(MOBenchmarkLanes<Lanes> const& function);
+    void step(MOBenchmarkLanes<Lanes> const& function);
+
+    // current parents of one run, values without penalty
+    void solution(std::size_t lane, std::vector<shark::RealVector>& points, std::vector<shark::RealVector>& values) const;
+
+   private:
+    // element e of slot s in lane l lives at (s * size + e) * Lanes + l
+    double* point(std::size_t s) { return m_points.data() + s * m_n * Lanes; }
+    double* factor(std::size_t s) { return m_factor.data() + s * m_triangle * Lanes; }
+    double* path(std::size_t s) { return m_path.data() + s * m_n * Lanes; }
+    double* lastStep(std::size_t s) { return m_lastStep.data() + s * m_n * Lanes; }
+
+    void mutate(std::size_t i);
+    void evaluate(MOBenchmarkLanes<Lanes> const& function, std::size_t s);
+    void select(std::size_t lane);
+    void updateStepSize(std::size_t s, double const* success);
+    void updateCovariance(std::size_t s);
+    // slot from takes the place of slot to in one lane
+    void move(std::size_t lane, std::size_t from, std::size_t to);
+
+    std::size_t m_mu;
+    double m_initialSigma;
+    NotionOfSuccess m_notionOfSuccess;
+    double m_penaltyFactor;
+    MOCMAConstants m_constants;
+    std::size_t m_n;
+    // n (n + 1) / 2 entries of the packed lower Cholesky factor
+    std::size_t m_triangle;
+
+    // parents in slots [0, mu), offspring in [mu, 2 mu)
+    std::vector<double> m_points;
+    std::vector<double> m_values;
+    std::vector<double> m_penalizedValues;
+    std::vector<double> m_stepSize;
+    std::vector<double> m_successProbability;
+    std::vector<double> m_path;
+    std::vector<double> m_factor;
+    std::vector<double> m_lastStep;
+    std::vector<unsigned int> m_rank;
+    std::vector<unsigned char> m_selected;
+    Philox m_streams[Lanes];
+
+    // scratch
+    std::vector<double> m_z;
+    // n deviates of one lane before they are interleaved into m_z
+    std::vector<double> m_normal;
+    std::vector<double> m_feasible;
+    std::vector<double> m_fitness;
+    std::vector<unsigned int> m_ranks;
+    std::vector<std::size_t> m_front;
+    std::vector<std::size_t> m_holes;
+    FrontSorter m_sorter;
+};
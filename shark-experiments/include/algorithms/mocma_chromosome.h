@@ -0,0 +1,62 @@
+/* mocma_chromosome.h
+ *
+ * DESCRIPTION
+ * Strategy parameters and update rules of a single MO-CMA-ES individual,
+ * shared by the generational and the steady-state variants in this
+ * directory. The covariance matrix is only kept as its lower Cholesky
+ * factor and adapted by rank-one updates of that factor.
+ *
+ * REFERENCES
+ * - C. Igel, N. Hansen and S. Roth. Covariance Matrix Adaptation for
+ *   Multi-objective Optimization. Evolutionary Computation 15(1), 2007.
+ * - C. Igel, T. Suttorp and N. Hansen. Steady-state Selection and Efficient
+ *   Covariance Matrix Update in the Multi-objective CMA-ES. EMO 2007.
+ */
+#pragma once
+
+#include <shark/LinAlg/Base.h>
+#include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+
+#include <cstddef>
+
+#include "algorithms/philox.h"
+
+// learning rates of [Igel 2007] table 1 for lambda = 1
+struct MOCMAConstants {
+    double stepSizeDamping;
+    double targetSuccessProbability;
+    double successProbabilityRate;
+    double evolutionPathRate;
+    double covarianceRate;
+    double successThreshold;
+
+    explicit MOCMAConstants(std::size_t n = 1);
+};
+
+// strategy parameters of one individual
+struct MOCMAChromosome {
+    double stepSize = 1.0;
+    double successProbability = 0.0;
+    shark::RealVector evolutionPath;
+    // lower triangular A with C = A A^T
+    shark::RealMatrix choleskyFactor;
+    // A z of the mutation that created the individual
+    shark::RealVector lastStep;
+
+    // reuses the storage if it already has dimension n
+    void init(std::size_t n, double sigma, MOCMAConstants const& constants);
+    // *this = other without reallocating if the dimensions agree
+    void assign(MOCMAChromosome const& other);
+    // point += stepSize * A z for a fresh standard normal z (scratch space),
+    // point has as many entries as the chromosome has dimensions
+    void mutate(double* point, shark::RealVector& z, Philox& rng);
+    void updateStepSize(double success, MOCMAConstants const& constants);
+    // adapt C along lastStep, O(n^2), lastStep is used up
+    void updateCovariance(MOCMAConstants const& constants);
+};
+
+// Evaluates point, or for points outside the box constraints its closest
+// feasible point (computed in feasible). penalizedValue adds penaltyFactor
+// times the squared distance to the feasible point to every objective (as
+// Shark's PenalizingEvaluator does) and is what selection should look at.
+void evaluatePenalized(shark::MultiObjectiveFunction const& function, shark::RealVector const& point, shark::RealVector& value, shark::RealVector& penalizedValue, shark::RealVector& feasible, double penaltyFactor = 1e-6);
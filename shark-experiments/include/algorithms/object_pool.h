@@ -0,0 +1,143 @@
+/* object_pool.h
+ *
+ * DESCRIPTION
+ * Recycling of temporaries inside the optimizers, so that a generation in
+ * steady state does not go through the heap.
+ *
+ * ObjectPool<T> hands out leases on default constructed objects and takes
+ * them back when the lease goes out of scope, without destroying them. A
+ * recycled object keeps its previous contents (and with them the capacity
+ * of its containers), the caller resets what it needs.
+ *
+ * NodeArena is a free list of equally sized blocks for node based
+ * containers, used through PoolAllocator. Freed nodes go back to the arena
+ * and are handed out again to the next insertion; the memory is only
+ * returned when the arena is destroyed. Neither class is thread safe.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+template <typename T>
+class ObjectPool {
+   public:
+    class Lease {
+       public:
+        Lease(Lease&& other) noexcept : m_pool(other.m_pool), m_object(std::move(other.m_object)) {}
+        Lease(Lease const&) = delete;
+        Lease& operator=(Lease const&) = delete;
+        ~Lease() {
+            if (m_object) m_pool->m_free.push_back(std::move(m_object));
+        }
+
+        T& operator*() const { return *m_object; }
+        T* operator->() const { return m_object.get(); }
+
+       private:
+        friend class ObjectPool;
+        Lease(ObjectPool* pool, std::unique_ptr<T> object) : m_pool(pool), m_object(std::move(object)) {}
+
+        ObjectPool* m_pool;
+        std::unique_ptr<T> m_object;
+    };
+
+    ObjectPool() = default;
+    ObjectPool(ObjectPool const&) = delete;
+    ObjectPool& operator=(ObjectPool const&) = delete;
+
+    Lease acquire() {
+        if (m_free.empty()) return Lease(this, std::unique_ptr<T>(new T()));
+        std::unique_ptr<T> object = std::move(m_free.back());
+        m_free.pop_back();
+        return Lease(this, std::move(object));
+    }
+
+    // objects waiting for reuse
+    std::size_t available() const { return m_free.size(); }
+
+   private:
+    std::vector<std::unique_ptr<T>> m_free;
+};
+
+class NodeArena {
+   public:
+    NodeArena() = default;
+    NodeArena(NodeArena const&) = delete;
+    NodeArena& operator=(NodeArena const&) = delete;
+    ~NodeArena() {
+        for (auto& list : m_lists) {
+            for (void* block : list.blocks) ::operator delete(block);
+        }
+    }
+
+    void* allocate(std::size_t bytes) {
+        List& list = find(bytes);
+        if (list.free.empty()) {
+            list.blocks.push_back(::operator new(bytes));
+            list.free.reserve(list.blocks.capacity());
+            return list.blocks.back();
+        }
+        void* block = list.free.back();
+        list.free.pop_back();
+        return block;
+    }
+
+    void deallocate(void* block, std::size_t bytes) { find(bytes).free.push_back(block); }
+
+   private:
+    struct List {
+        std::size_t bytes;
+        // every block ever allocated, owned by the arena
+        std::vector<void*> blocks;
+        std::vector<void*> free;
+    };
+
+    // a container only uses a couple of node sizes
+    List& find(std::size_t bytes) {
+        for (auto& list : m_lists) {
+            if (list.bytes == bytes) return list;
+        }
+        m_lists.push_back(List{bytes, {}, {}});
+        return m_lists.back();
+    }
+
+    std::vector<List> m_lists;
+};
+
+// single objects come from a shared NodeArena, arrays from the heap
+template <typename T>
+class PoolAllocator {
+   public:
+    typedef T value_type;
+
+    explicit PoolAllocator(std::shared_ptr<NodeArena> arena) : m_arena(std::move(arena)) {}
+    template <typename U>
+    PoolAllocator(PoolAllocator<U> const& other) : m_arena(other.arena()) {}
+
+    T* allocate(std::size_t n) {
+        if (n != 1) return static_cast<T*>(::operator new(n * sizeof(T)));
+        return static_cast<T*>(m_arena->allocate(sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        if (n != 1) {
+            ::operator delete(p);
+            return;
+        }
+        m_arena->deallocate(p, sizeof(T));
+    }
+
+    std::shared_ptr<NodeArena> const& arena() const { return m_arena; }
+
+    template <typename U>
+    bool operator==(PoolAllocator<U> const& other) const { return m_arena == other.arena(); }
+    template <typename U>
+    bool operator!=(PoolAllocator<U> const& other) const { return m_arena != other.arena(); }
+
+   private:
+    std::shared_ptr<NodeArena> m_arena;
+};
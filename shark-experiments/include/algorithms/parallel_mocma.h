@@ -0,0 +1,117 @@
+/* parallel_mocma.h
+ *
+ * DESCRIPTION
+ * (mu+mu)-MO-CMA-ES with the per-offspring work of a generation spread over
+ * a thread pool. Mutation (one triangular matrix-vector product per
+ * offspring), evaluation and the rank-one Cholesky updates of the selected
+ * offspring are independent across offspring and run in parallel;
+ * non-dominated sorting and hypervolume selection stay sequential.
+ *
+ * Every offspring slot owns its own Philox stream of one seed drawn from
+ * shark::random::globalRng() in init(), so a run gives the same result for
+ * any number of threads. Objective functions are only called concurrently
+ * if they declare themselves thread safe, otherwise evaluation stays on
+ * the calling thread (the evaluation counters of the Shark benchmarks are
+ * plain integers).
+ *
+ * REFERENCES
+ * - C. Igel, N. Hansen and S. Roth. Covariance Matrix Adaptation for
+ *   Multi-objective Optimization. Evolutionary Computation 15(1), 2007.
+ * - T. Voss, N. Hansen and C. Igel. Improved Step Size Adaptation for the
+ *   MO-CMA-ES. GECCO 2010.
+ */
+#pragma once
+
+#include <shark/Algorithms/AbstractMultiObjectiveOptimizer.h>
+#include <shark/LinAlg/Base.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "algorithms/front_sorter.h"
+#include "algorithms/mocma_chromosome.h"
+#include "algorithms/population_store.h"
+#include "parallel/thread_pool.h"
+
+class ParallelMOCMA : public shark::AbstractMultiObjectiveOptimizer<shark::RealVector> {
+   public:
+    enum class NotionOfSuccess { IndividualBased, PopulationBased };
+
+    // mirrors indicator().setReference() of Shark's MOCMA
+    struct Indicator {
+        // empty: worst value of the front in each objective plus one
+        shark::RealVector reference;
+        void setReference(shark::RealVector const& point) { reference = point; }
+    };
+
+    // threads counts the calling thread, 0 means one per hardware thread
+    explicit ParallelMOCMA(std::size_t threads = 1);
+
+    std::string name() const override { return "ParallelMOCMA"; }
+
+    std::size_t mu() const { return m_mu; }
+    std::size_t& mu() { return m_mu; }
+    double initialSigma() const { return m_initialSigma; }
+    double& initialSigma() { return m_initialSigma; }
+    NotionOfSuccess notionOfSuccess() const { return m_notionOfSuccess; }
+    NotionOfSuccess& notionOfSuccess() { return m_notionOfSuccess; }
+    Indicator& indicator() { return m_indicator; }
+    std::size_t threads() const { return m_pool->size(); }
+    // the current parents are the first mu rows
+    PopulationStore const& population() const { return m_store; }
+
+    // replaces the pool, takes effect immediately
+    void setThreads(std::size_t threads);
+
+    void init(ObjectiveFunctionType const& function) override;
+    void init(ObjectiveFunctionType const& function, std::vector<SearchPointType> const& initialSearchPoints) override;
+    void step(ObjectiveFunctionType const& function) override;
+
+   private:
+    // strategy parameters of row i of m_store
+    struct Individual {
+        MOCMAChromosome chromosome;
+        std::size_t parent = 0;
+        std::size_t rank = 0;
+        bool selected = false;
+    };
+
+    // per worker vectors for the objective function interface
+    struct Scratch {
+        // standard normal sample
+        shark::RealVector z;
+        shark::RealVector point;
+        shark::RealVector value;
+        shark::RealVector penalizedValue;
+        shark::RealVector feasible;
+    };
+
+    void mutate(std::size_t i, std::size_t worker);
+    void evaluate(ObjectiveFunctionType const& function, std::size_t i, std::size_t worker);
+    void select();
+    void updateSolution();
+
+    std::size_t m_mu;
+    double m_initialSigma;
+    NotionOfSuccess m_notionOfSuccess;
+    Indicator m_indicator;
+    double m_penaltyFactor;
+    MOCMAConstants m_constants;
+
+    // parents in [0, mu), offspring in [mu, 2 mu)
+    PopulationStore m_store;
+    std::vector<Individual> m_population;
+    std::vector<Philox> m_streams;
+    std::vector<Scratch> m_scratch;
+    FrontSorter m_sorter;
+    // selection scratch, kept across generations
+    std::vector<unsigned int> m_ranks;
+    std::vector<std::vector<std::size_t>> m_fronts;
+    std::vector<shark::RealVector> m_frontValues;
+    std::vector<double> m_contributions;
+    std::vector<std::size_t> m_order;
+    shark::RealVector m_reference;
+    std::unique_ptr<ThreadPool> m_pool;
+};
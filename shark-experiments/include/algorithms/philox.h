@@ -0,0 +1,67 @@
+/* philox.h
+ *
+ * DESCRIPTION
+ * Philox4x32-10 counter-based random number generator with bulk normal
+ * sampling. Output block i of stream s under seed k is the Philox
+ * permutation of the counter (i, s) under key k, so any number of
+ * reproducible, non-overlapping streams can be split off one seed without
+ * seeding sequences, and a block can be computed without the ones before
+ * it. normal() fills whole buffers: it encrypts a batch of counters in
+ * loops the compiler vectorises and turns every 128 bit block into two
+ * deviates with the Box-Muller transform, instead of one
+ * std::normal_distribution call (with rejection) per number.
+ *
+ * The class is a UniformRandomBitGenerator, so the std distributions work
+ * on it as well.
+ *
+ * REFERENCES
+ * - J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw. Parallel Random
+ *   Numbers: As Easy as 1, 2, 3. SC 2011.
+ * - G. E. P. Box and M. E. Muller. A Note on the Generation of Random
+ *   Normal Deviates. Annals of Mathematical Statistics 29(2), 1958.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class Philox {
+   public:
+    typedef std::uint32_t result_type;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return 0xffffffffu; }
+
+    explicit Philox(std::uint64_t seed = 0, std::uint64_t stream = 0) { this->seed(seed, stream); }
+
+    // restart at block 0 of the given stream
+    void seed(std::uint64_t seed, std::uint64_t stream = 0);
+    // block 0 of another stream of the same seed
+    Philox split(std::uint64_t stream) const { return Philox(m_key, stream); }
+
+    std::uint64_t key() const { return m_key; }
+    std::uint64_t stream() const { return m_stream; }
+    // index of the next block that will be generated
+    std::uint64_t position() const { return m_counter; }
+
+    result_type operator()() {
+        if (m_used == 4) {
+            block(m_key, m_counter++, m_stream, m_buffer);
+            m_used = 0;
+        }
+        return m_buffer[m_used++];
+    }
+
+    // n standard normal deviates, using ceil(n / 2) fresh blocks; does not
+    // touch the words buffered for operator()
+    void normal(double* out, std::size_t n);
+
+    // the four words of block counter of stream under key
+    static void block(std::uint64_t key, std::uint64_t counter, std::uint64_t stream, std::uint32_t* out);
+
+   private:
+    std::uint64_t m_key;
+    std::uint64_t m_stream;
+    std::uint64_t m_counter;
+    std::uint32_t m_buffer[4];
+    unsigned int m_used;
+};
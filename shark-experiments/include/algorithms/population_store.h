@@ -0,0 +1,59 @@
+/* population_store.h
+ *
+ * DESCRIPTION
+ * Structure-of-arrays storage for the search points and objective values
+ * of a population. Individual i is row i of three row-major matrices
+ * (points, values and penalized values) that each live in one contiguous
+ * buffer, so sorting and selection stream through the objective matrix
+ * and a snapshot of the first rows is a single memcpy. Strategy parameters
+ * stay with the optimizer, indexed by the same row.
+ */
+#pragma once
+
+#include <shark/LinAlg/Base.h>
+
+#include <cstddef>
+#include <vector>
+
+class PopulationStore {
+   public:
+    PopulationStore();
+
+    // keeps the allocation if the new shape fits into it
+    void resize(std::size_t size, std::size_t numberOfVariables, std::size_t numberOfObjectives);
+
+    std::size_t size() const { return m_size; }
+    std::size_t numberOfVariables() const { return m_numberOfVariables; }
+    std::size_t numberOfObjectives() const { return m_numberOfObjectives; }
+
+    double* point(std::size_t i) { return m_points.data() + i * m_numberOfVariables; }
+    double const* point(std::size_t i) const { return m_points.data() + i * m_numberOfVariables; }
+    double* value(std::size_t i) { return m_values.data() + i * m_numberOfObjectives; }
+    double const* value(std::size_t i) const { return m_values.data() + i * m_numberOfObjectives; }
+    // value plus the box constraint penalty, used for selection
+    double* penalizedValue(std::size_t i) { return m_penalizedValues.data() + i * m_numberOfObjectives; }
+    double const* penalizedValue(std::size_t i) const { return m_penalizedValues.data() + i * m_numberOfObjectives; }
+
+    // whole matrices, size x numberOfVariables and size x numberOfObjectives
+    double const* points() const { return m_points.data(); }
+    double const* values() const { return m_values.data(); }
+    double const* penalizedValues() const { return m_penalizedValues.data(); }
+
+    // row to = row from
+    void copy(std::size_t from, std::size_t to);
+    void swap(std::size_t a, std::size_t b);
+
+    // Shark vectors of a row, for the objective function interface
+    void getPoint(std::size_t i, shark::RealVector& point) const;
+    void setPoint(std::size_t i, shark::RealVector const& point);
+    void getValue(std::size_t i, shark::RealVector& value) const;
+    void setValues(std::size_t i, shark::RealVector const& value, shark::RealVector const& penalizedValue);
+
+   private:
+    std::size_t m_size;
+    std::size_t m_numberOfVariables;
+    std::size_t m_numberOfObjectives;
+    std::vector<double> m_points;
+    std::vector<double> m_values;
+    std::vector<double> m_penalizedValues;
+};
@@ -0,0 +1,97 @@
+/* steady_state_mocma.h
+ *
+ * DESCRIPTION
+ * (mu+1)-MO-CMA-ES for two objectives whose population lives in an
+ * IncrementalFront2D. Each step inserts one offspring and removes the least
+ * hypervolume contributor of the worst front, so ranks and contributions
+ * are updated locally instead of re-sorting the whole population and
+ * recomputing the last front's contributions. The per-step overhead besides
+ * the O(n^2) mutation and covariance update is O(log^2 mu) for typical
+ * steps (plus O(mu) pointer steps to draw the parent).
+ *
+ * Like shark::SteadyStateMOCMA, it measures contributions against the
+ * worst point of the front plus one unless indicator().setReference() is
+ * called. Differences: only two objectives are supported, ties between
+ * least contributors may be broken differently, and random numbers come
+ * from an own Philox stream seeded from shark::random::globalRng(), so runs
+ * are not those of Shark's optimizer.
+ *
+ * REFERENCES
+ * - C. Igel, T. Suttorp and N. Hansen. Steady-state Selection and Efficient
+ *   Covariance Matrix Update in the Multi-objective CMA-ES. EMO 2007.
+ */
+#pragma once
+
+#include <shark/Algorithms/AbstractMultiObjectiveOptimizer.h>
+#include <shark/LinAlg/Base.h>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "algorithms/incremental_front.h"
+#include "algorithms/mocma_chromosome.h"
+#include "algorithms/population_store.h"
+
+class IncrementalSteadyStateMOCMA : public shark::AbstractMultiObjectiveOptimizer<shark::RealVector> {
+   public:
+    enum class NotionOfSuccess { IndividualBased, PopulationBased };
+
+    // mirrors indicator().setReference() of Shark's SteadyStateMOCMA
+    struct Indicator {
+        // empty: the worst point of every front plus one
+        shark::RealVector reference;
+        void setReference(shark::RealVector const& point) { reference = point; }
+    };
+
+    IncrementalSteadyStateMOCMA();
+
+    std::string name() const override { return "IncrementalSteadyStateMOCMA"; }
+
+    std::size_t mu() const { return m_mu; }
+    std::size_t& mu() { return m_mu; }
+    double initialSigma() const { return m_initialSigma; }
+    double& initialSigma() { return m_initialSigma; }
+    NotionOfSuccess notionOfSuccess() const { return m_notionOfSuccess; }
+    NotionOfSuccess& notionOfSuccess() { return m_notionOfSuccess; }
+    Indicator& indicator() { return m_indicator; }
+
+    void init(ObjectiveFunctionType const& function) override;
+    void init(ObjectiveFunctionType const& function, std::vector<SearchPointType> const& initialSearchPoints) override;
+    void step(ObjectiveFunctionType const& function) override;
+
+   private:
+    // strategy parameters of row i of m_store
+    struct Individual {
+        MOCMAChromosome chromosome;
+        // handle in m_front
+        std::size_t handle = 0;
+        // entry in m_best
+        std::size_t solution = 0;
+    };
+
+    void evaluate(ObjectiveFunctionType const& function, std::size_t slot);
+
+    std::size_t m_mu;
+    double m_initialSigma;
+    NotionOfSuccess m_notionOfSuccess;
+    Indicator m_indicator;
+    double m_penaltyFactor;
+    MOCMAConstants m_constants;
+
+    // mu + 1 slots, m_spare is the one not in the population
+    PopulationStore m_store;
+    std::vector<Individual> m_individuals;
+    std::size_t m_spare;
+    // front handle to slot
+    std::vector<std::size_t> m_slots;
+    IncrementalFront2D m_front;
+    Philox m_rng;
+    // scratch vectors for the objective function interface
+    shark::RealVector m_z;
+    shark::RealVector m_point;
+    shark::RealVector m_value;
+    shark::RealVector m_penalizedValue;
+    shark::RealVector m_feasible;
+};
@@ -0,0 +1,53 @@
+/* checkpoint.h
+ *
+ * DESCRIPTION
+ * Mid-run checkpoints of a Shark optimizer. A checkpoint holds the complete
+ * state of the optimizer (its own serialisation, which Shark's MOCMA,
+ * SteadyStateMOCMA, SMSEMOA and RealCodedNSGAII implement in full), the
+ * state of shark::random::globalRng() and the evaluation counter of the
+ * objective function. Doubles are stored as raw bytes, so a run restored
+ * from a checkpoint continues bit for bit as the run that wrote it would
+ * have. One long prefix can seed many continuations, and a killed run can
+ * resume where its last checkpoint was taken.
+ *
+ * File layout:
+ *   header:  "CKPT" (4 bytes), version (1 byte)
+ *   body:    Boost polymorphic binary archive of the optimizer name,
+ *            evaluations, step, the generator state and the optimizer
+ * The step is free for the driver, e.g. the next budget milestone.
+ * saveCheckpoint() writes to a temporary file and renames it, so a run
+ * killed while saving leaves the previous checkpoint intact.
+ *
+ * Optimizers of this repository do not serialise their state (their
+ * read() and write() are the empty defaults) and cannot be checkpointed.
+ */
+#pragma once
+
+#include <shark/Algorithms/AbstractMultiObjectiveOptimizer.h>
+#include <shark/LinAlg/Base.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+struct CheckpointInfo {
+    std::string optimizer;
+    std::uint64_t evaluations = 0;
+    std::uint64_t step = 0;
+};
+
+// also saves shark::random::globalRng()
+void saveCheckpoint(std::string const& filename, shark::AbstractMultiObjectiveOptimizer<shark::RealVector> const& optimizer, std::uint64_t evaluations,
+                    std::uint64_t step = 0);
+// restores the optimizer and shark::random::globalRng(); the optimizer must
+// have the name of the saved one
+CheckpointInfo loadCheckpoint(std::string const& filename, shark::AbstractMultiObjectiveOptimizer<shark::RealVector>& optimizer);
+
+// Shark's objective functions keep their evaluation counter protected; a
+// run that resumes from a checkpoint declares Resumable<Function> to set it.
+template <typename Function>
+class Resumable : public Function {
+   public:
+    using Function::Function;
+    void setEvaluationCounter(std::size_t evaluations) { this->m_evaluationCounter = evaluations; }
+};
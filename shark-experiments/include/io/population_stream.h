@@ -0,0 +1,133 @@
+/* population_stream.h
+ *
+ * DESCRIPTION
+ * Compact binary stream of population snapshots. Every frame stores the
+ * decision and objective vectors of one generation. Selection reorders the
+ * population every generation, so each row of a frame is XOR-encoded
+ * against a row of the previous frame chosen by content: the row with the
+ * same decision vector if there is one (a survivor of selection), else the
+ * row nearest in the first objective (a parent, often). The residuals are
+ * packed by dropping their zero bytes, so survivors cost about a byte and
+ * offspring keep the sign, exponent and leading mantissa bytes they share
+ * with their reference.
+ *
+ * Stream layout (all integers are LEB128 varints unless noted):
+ *   header:  "PSNP" (4 bytes), version (1 byte)
+ *   frame:   kind ('K' keyframe or 'D' delta, 1 byte), generation,
+ *            evaluations, size, numberOfVariables, numberOfObjectives,
+ *            payload length, payload
+ * The payload starts with the reference of every row, 0 for none (all
+ * rows of a keyframe) or 1 + the row in the previous frame. Then follow
+ * size * (numberOfVariables + numberOfObjectives) residuals, row by row,
+ * each row its point and then its value. Each residual starts with a
+ * control byte:
+ *   0..80    lead * 9 + trail, followed by the 8 - lead - trail middle
+ *            bytes of the residual (lead/trail = zero bytes stripped from
+ *            the most/least significant end)
+ *   128..255 run of (control - 127) zero residuals
+ *
+ * REFERENCES
+ * - T. Pelkonen et al. Gorilla: A Fast, Scalable, In-Memory Time Series
+ *   Database. VLDB 2015.
+ */
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct PopulationSnapshot {
+    std::uint64_t generation = 0;
+    std::uint64_t evaluations = 0;
+    std::size_t size = 0;
+    std::size_t numberOfVariables = 0;
+    std::size_t numberOfObjectives = 0;
+    // row-major, size x numberOfVariables
+    std::vector<double> points;
+    // row-major, size x numberOfObjectives
+    std::vector<double> values;
+
+    // copy the points and values of a Shark solution set
+    template <typename Solution>
+    void assign(std::uint64_t generation, std::uint64_t evaluations, Solution const& solution);
+    // copy row-major point and value matrices, e.g. of a PopulationStore
+    void assign(std::uint64_t generation, std::uint64_t evaluations, std::size_t size, std::size_t numberOfVariables, std::size_t numberOfObjectives, double const* points, double const* values);
+};
+
+class PopulationStreamWriter {
+   public:
+    // Every keyframeInterval-th frame is stored without reference to its
+    // predecessor so that a damaged stream can be resynchronised.
+    explicit PopulationStreamWriter(std::string const& filename, unsigned int keyframeInterval = 256);
+    ~PopulationStreamWriter();
+
+    void write(PopulationSnapshot const& snapshot);
+
+    template <typename Solution>
+    void write(std::uint64_t generation, std::uint64_t evaluations, Solution const& solution) {
+        m_snapshot.assign(generation, evaluations, solution);
+        write(m_snapshot);
+    }
+
+    void close();
+
+    std::uint64_t frames() const { return m_frames; }
+    std::uint64_t bytesWritten() const { return m_bytesWritten; }
+
+   private:
+    // chooses the reference rows of the current frame (1 + row, 0 for none)
+    void reference(std::vector<std::uint64_t> const& current, std::size_t size);
+
+    std::ofstream m_out;
+    unsigned int m_keyframeInterval;
+    std::uint64_t m_frames;
+    std::uint64_t m_bytesWritten;
+    std::size_t m_size;
+    std::size_t m_numberOfVariables;
+    std::size_t m_numberOfObjectives;
+    // rows of the previous and the current frame as bits, row-major
+    std::vector<std::uint64_t> m_previous;
+    std::vector<std::uint64_t> m_current;
+    std::vector<std::size_t> m_references;
+    // previous rows by hash of their point, and ordered by first objective
+    std::unordered_map<std::uint64_t, std::size_t> m_index;
+    std::vector<std::pair<std::uint64_t, std::size_t>> m_order;
+    std::vector<unsigned char> m_payload;
+    std::vector<unsigned char> m_frame;
+    PopulationSnapshot m_snapshot;
+};
+
+class PopulationStreamReader {
+   public:
+    explicit PopulationStreamReader(std::string const& filename);
+
+    // read the next frame, returns false at the end of the stream
+    bool read(PopulationSnapshot& snapshot);
+
+   private:
+    std::ifstream m_in;
+    std::size_t m_size;
+    std::size_t m_width;
+    std::vector<std::uint64_t> m_previous;
+    std::vector<std::uint64_t> m_current;
+    std::vector<std::size_t> m_references;
+    std::vector<unsigned char> m_payload;
+};
+
+template <typename Solution>
+void PopulationSnapshot::assign(std::uint64_t generation, std::uint64_t evaluations, Solution const& solution) {
+    this->generation = generation;
+    this->evaluations = evaluations;
+    size = solution.size();
+    numberOfVariables = size > 0 ? solution[0].point.size() : 0;
+    numberOfObjectives = size > 0 ? solution[0].value.size() : 0;
+    points.resize(size * numberOfVariables);
+    values.resize(size * numberOfObjectives);
+    for (std::size_t i = 0; i != size; i++) {
+        for (std::size_t j = 0; j != numberOfVariables; j++) points[i * numberOfVariables + j] = solution[i].point[j];
+        for (std::size_t j = 0; j != numberOfObjectives; j++) values[i * numberOfObjectives + j] = solution[i].value[j];
+    }
+}
@@ -0,0 +1,91 @@
+/* run_cache.h
+ *
+ * DESCRIPTION
+ * Content-addressed cache for the outputs of the cells of an experiment
+ * sweep, so that a sweep run again only computes the cells it has not
+ * computed before. A RunKey lists everything the result of a cell depends
+ * on as name=value lines (function, dimension, instance, optimizer and its
+ * settings, budget, seed). They follow two lines that hold for the whole
+ * build:
+ *   build=    EXPERIMENTS_BUILD_ID, computed by cmake/build_id.cmake on
+ *             every build from a hash of the installed Shark library, the
+ *             Shark version, the compiler, the build type and the compile
+ *             options (including EXPERIMENTS_NATIVE_ARCH)
+ *   results=  RESULTS_VERSION in run_cache.cpp, bumped by hand whenever a
+ *             change to an optimizer or a benchmark changes the results
+ * Other changes to the code, such as a new optimizer column, keep the
+ * entries of the existing cells. Entries of an old build stay on disk until
+ * the cache directory is deleted.
+ *
+ * The entry of a key is the file <directory>/<hh>/<hash>, named after the
+ * 64-bit hash of the key text:
+ *   header:  "RUNC" (4 bytes), version (1 byte)
+ *   body:    Boost polymorphic binary archive of the key text and the
+ *            named outputs of the cell (e.g. file name -> contents)
+ * The stored key text is compared on load, so a hash collision reads as a
+ * miss. store() writes a temporary file and renames it, so a killed run or
+ * another sweep sharing the directory never sees a partial entry.
+ *
+ * A cell can only be cached if its result does not depend on the cells
+ * before it, i.e. it must not continue a random number stream shared with
+ * them. RunKey::seed() derives the seed of a cell from the configuration
+ * lines of its key only, so a new build or results version reruns a cell
+ * with the same seed.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+
+class RunKey {
+   public:
+    RunKey();
+
+    template <typename T>
+    RunKey& add(std::string const& name, T const& value) {
+        std::ostringstream text;
+        text << std::setprecision(std::numeric_limits<double>::max_digits10) << value;
+        m_text += name + "=" + text.str() + "\n";
+        return *this;
+    }
+
+    std::string const& text() const { return m_text; }
+    std::uint64_t hash() const;
+    // seed of the random number generator of the cell, without the build lines
+    std::uint64_t seed() const;
+
+   private:
+    std::string m_text;
+    // start of the configuration lines in m_text
+    std::size_t m_configuration;
+};
+
+class RunCache {
+   public:
+    // outputs of a cell by name
+    typedef std::map<std::string, std::string> Outputs;
+
+    // the directory is created on the first store()
+    explicit RunCache(std::string directory);
+
+    std::string const& directory() const { return m_directory; }
+
+    // false if the cell is not cached
+    bool load(RunKey const& key, Outputs& outputs);
+    void store(RunKey const& key, Outputs const& outputs);
+
+    std::size_t hits() const { return m_hits; }
+    std::size_t misses() const { return m_misses; }
+
+   private:
+    std::string filename(RunKey const& key) const;
+
+    std::string m_directory;
+    std::size_t m_hits;
+    std::size_t m_misses;
+};
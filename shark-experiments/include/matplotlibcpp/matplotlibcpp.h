@@ -11,6 +11,7 @@
 #include <functional>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <numeric>
 #include <stdexcept>
 #include <vector>
@@ -318,6 +319,20 @@ inline bool annotate(std::string annotation, double x, double y) {
     return res;
 }
 
+/// Strided view of an existing buffer, handed to NumPy without copying.
+///
+/// `stride` is in elements. If `owner` is set, the NumPy array shares
+/// ownership of the buffer through a capsule, so the data stays valid as long
+/// as matplotlib holds on to the array (e.g. until the figure is closed).
+/// Without an owner the caller has to keep the buffer alive until then.
+template <typename Numeric>
+struct array_view {
+    const Numeric* data;
+    std::size_t size;
+    std::ptrdiff_t stride;
+    std::shared_ptr<const void> owner;
+};
+
 namespace detail {
 
 #ifndef WITHOUT_NUMPY
@@ -357,24 +372,52 @@ template <>
 struct select_npy_type<unsigned long long> { const static NPY_TYPES type = NPY_UINT64; };
 // TODO: add int, long, etc.
 
+static const char* const s_owner_capsule = "matplotlibcpp.owner";
+
+inline void release_owner(PyObject* capsule) {
+    delete static_cast<std::shared_ptr<const void>*>(PyCapsule_GetPointer(capsule, s_owner_capsule));
+}
+
 template <typename Numeric>
-PyObject* get_array(const std::vector<Numeric>& v) {
-    npy_intp vsize = v.size();
+PyObject* get_array(const array_view<Numeric>& v) {
+    npy_intp vsize = v.size;
     NPY_TYPES type = select_npy_type<Numeric>::type;
     if (type == NPY_NOTYPE) {
-        size_t memsize = v.size() * sizeof(double);
-        double* dp = static_cast<double*>(::malloc(memsize));
-        for (size_t i = 0; i < v.size(); ++i)
-            dp[i] = v[i];
-        PyObject* varray = PyArray_SimpleNewFromData(1, &vsize, NPY_DOUBLE, dp);
-        PyArray_UpdateFlags(reinterpret_cast<PyArrayObject*>(varray), NPY_ARRAY_OWNDATA);
+        // no matching dtype, this is the only case that copies
+        PyObject* varray = PyArray_SimpleNew(1, &vsize, NPY_DOUBLE);
+        if (!varray) throw std::runtime_error("Failed to allocate numpy array.");
+        double* dp = static_cast<double*>(PyArray_DATA(reinterpret_cast<PyArrayObject*>(varray)));
+        for (size_t i = 0; i < v.size; ++i)
+            dp[i] = v.data[static_cast<std::ptrdiff_t>(i) * v.stride];
         return varray;
     }
 
-    PyObject* varray = PyArray_SimpleNewFromData(1, &vsize, type, (void*)(v.data()));
+    // read-only, the buffer belongs to the caller
+    npy_intp vstride = v.stride * static_cast<npy_intp>(sizeof(Numeric));
+    PyObject* varray = PyArray_New(&PyArray_Type, 1, &vsize, type, &vstride, const_cast<Numeric*>(v.data), 0, NPY_ARRAY_ALIGNED, nullptr);
+    if (!varray) throw std::runtime_error("Failed to create numpy array view.");
+    if (v.owner) {
+        auto* owner = new std::shared_ptr<const void>(v.owner);
+        PyObject* capsule = PyCapsule_New(owner, s_owner_capsule, &release_owner);
+        if (!capsule) {
+            delete owner;
+            Py_DECREF(varray);
+            throw std::runtime_error("Failed to create numpy base capsule.");
+        }
+        // steals the capsule reference, also on failure
+        if (PyArray_SetBaseObject(reinterpret_cast<PyArrayObject*>(varray), capsule) != 0) {
+            Py_DECREF(varray);
+            throw std::runtime_error("Failed to attach numpy base object.");
+        }
+    }
     return varray;
 }
 
+template <typename Numeric>
+PyObject* get_array(const std::vector<Numeric>& v) {
+    return get_array(array_view<Numeric>{v.data(), v.size(), 1, nullptr});
+}
+
 template <typename Numeric>
 PyObject* get_2darray(const std::vector<::std::vector<Numeric>>& v) {
     if (v.size() < 1) throw std::runtime_error("get_2d_array v too small");
@@ -408,6 +451,15 @@ PyObject* get_array(const std::vector<Numeric>& v) {
     return list;
 }
 
+template <typename Numeric>
+PyObject* get_array(const array_view<Numeric>& v) {
+    PyObject* list = PyList_New(v.size);
+    for (size_t i = 0; i < v.size; ++i) {
+        PyList_SetItem(list, i, PyFloat_FromDouble(v.data[static_cast<std::ptrdiff_t>(i) * v.stride]));
+    }
+    return list;
+}
+
 #endif  // WITHOUT_NUMPY
 
 // sometimes, for labels and such, we need string arrays
@@ -1127,6 +1179,31 @@ bool plot(const std::vector<NumericX>& x, const std::vector<NumericY>& y, const
     return res;
 }
 
+/// Same as above for views of existing buffers, nothing is copied.
+template <typename NumericX, typename NumericY>
+bool plot(const array_view<NumericX>& x, const array_view<NumericY>& y, const std::string& s = "") {
+    assert(x.size == y.size);
+
+    detail::_interpreter::get();
+
+    PyObject* xarray = detail::get_array(x);
+    PyObject* yarray = detail::get_array(y);
+
+    PyObject* pystring = PyString_FromString(s.c_str());
+
+    PyObject* plot_args = PyTuple_New(3);
+    PyTuple_SetItem(plot_args, 0, xarray);
+    PyTuple_SetItem(plot_args, 1, yarray);
+    PyTuple_SetItem(plot_args, 2, pystring);
+
+    PyObject* res = PyObject_CallObject(detail::_interpreter::get().s_python_function_plot, plot_args);
+
+    Py_DECREF(plot_args);
+    if (res) Py_DECREF(res);
+
+    return res;
+}
+
 template <typename NumericX, typename NumericY, typename NumericZ>
 bool contour(const std::vector<NumericX>& x, const std::vector<NumericY>& y,
              const std::vector<NumericZ>& z,
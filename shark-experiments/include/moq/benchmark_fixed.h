@@ -0,0 +1,81 @@
+/* benchmark_fixed.h
+ *
+ * DESCRIPTION
+ * MOBenchmark with the dimension fixed at compile time. The instance is
+ * generated by MOBenchmark as usual; MOBenchmarkN<N> then keeps a copy of
+ * the transposed factors A_i^T and the optima in aligned arrays inside the
+ * object and evaluates both quadratic forms with loops of constant trip
+ * count, which the compiler unrolls and vectorises, instead of going
+ * through dynamically sized Shark vectors (and their allocations for the
+ * temporaries x - x_i^* and A_i^T (x - x_i^*)).
+ *
+ * makeMOBenchmark() returns the specialisation for the dimensions used in
+ * the sweeps and the runtime-sized MOBenchmark for any other dimension.
+ *
+ * The quadratic forms sum in another order than Shark's matrix-vector
+ * products, so values differ from those of MOBenchmark in the last bits,
+ * and runs on an MOBenchmarkN are not bit-identical to runs on the
+ * MOBenchmark of the same instance.
+ */
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "moq/benchmarks.h"
+
+template <std::size_t N>
+class MOBenchmarkN : public MOBenchmark {
+   public:
+    MOBenchmarkN(std::string const& name, unsigned int instance, double kappa = 1e3, Storage storage = Storage::Full, EigenSolver solver = EigenSolver::Full)
+        : MOBenchmark(name, N, instance, kappa, storage, solver), m_a1(a1()), m_a2(a2()), m_b1(b1()), m_b2(b2()), m_s(s()) {
+        for (std::size_t i = 0; i != N; i++) {
+            for (std::size_t j = 0; j != N; j++) {
+                m_A1T[i * N + j] = A1()(j, i);
+                m_A2T[i * N + j] = A2()(j, i);
+            }
+            m_x1[i] = x1star()(i);
+            m_x2[i] = x2star()(i);
+        }
+    }
+
+    ResultType eval(SearchPointType const& x) const override {
+        countEvaluation();
+        alignas(64) double point[N];
+        for (std::size_t j = 0; j != N; j++) point[j] = x(j);
+        return ResultType{
+            0.5 * m_a1 * std::pow(quadraticForm(m_A1T, m_x1, point), m_s) + m_b1,
+            0.5 * m_a2 * std::pow(quadraticForm(m_A2T, m_x2, point), m_s) + m_b2};
+    }
+
+   private:
+    // |A^T (x - c)|^2
+    static double quadraticForm(double const* AT, double const* c, double const* x) {
+        alignas(64) double difference[N];
+        for (std::size_t j = 0; j != N; j++) difference[j] = x[j] - c[j];
+        double ret = 0.0;
+        for (std::size_t i = 0; i != N; i++) {
+            double d = 0.0;
+            for (std::size_t j = 0; j != N; j++) d += AT[i * N + j] * difference[j];
+            ret += d * d;
+        }
+        return ret;
+    }
+
+    alignas(64) double m_A1T[N * N];
+    alignas(64) double m_A2T[N * N];
+    alignas(64) double m_x1[N];
+    alignas(64) double m_x2[N];
+    double m_a1;
+    double m_a2;
+    double m_b1;
+    double m_b2;
+    double m_s;
+};
+
+// MOBenchmarkN<dimension> for dimension 2, 3, 5, 10, 20 and 40, else MOBenchmark; both with the given storage and solver
+std::unique_ptr<MOBenchmark> makeMOBenchmark(std::string const& name, unsigned int dimension, unsigned int instance, double kappa = 1e3,
+                                             MOBenchmark::Storage storage = MOBenchmark::Storage::Full,
+                                             MOBenchmark::EigenSolver solver = MOBenchmark::EigenSolver::Full);
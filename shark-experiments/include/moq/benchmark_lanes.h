@@ -0,0 +1,56 @@
+/* benchmark_lanes.h
+ *
+ * DESCRIPTION
+ * Lanes independent MOBenchmark instances of the same dimension evaluated
+ * together, one search point per instance. All data is interleaved across
+ * the instances (element e of lane l is stored at e * Lanes + l), so every
+ * step of the two quadratic forms is a loop over the lanes that the
+ * compiler turns into full width vector instructions, instead of the short
+ * dimension-length loops of a single evaluation.
+ *
+ * Points and values passed to eval() use the same layout: points is
+ * n x Lanes (variable major), values is 2 x Lanes. Evaluations are counted
+ * per call, i.e. once for all lanes.
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "moq/benchmarks.h"
+
+template <std::size_t Lanes>
+class MOBenchmarkLanes {
+   public:
+    // all instances need the same dimension
+    explicit MOBenchmarkLanes(std::vector<MOBenchmark const*> const& instances);
+
+    std::size_t numberOfVariables() const { return m_dimension; }
+    std::size_t evaluationCounter() const { return m_evaluationCounter; }
+    void init() { m_evaluationCounter = 0; }
+
+    // box constraints, n x Lanes
+    double const* lower() const { return m_lower.data(); }
+    double const* upper() const { return m_upper.data(); }
+
+    // not thread safe, uses internal scratch space
+    void eval(double const* points, double* values) const;
+
+   private:
+    std::size_t m_dimension;
+    // A_i^T, n x n x Lanes
+    std::vector<double> m_A1T;
+    std::vector<double> m_A2T;
+    // optima, n x Lanes
+    std::vector<double> m_x1;
+    std::vector<double> m_x2;
+    double m_a1[Lanes];
+    double m_a2[Lanes];
+    double m_b1[Lanes];
+    double m_b2[Lanes];
+    double m_s[Lanes];
+    std::vector<double> m_lower;
+    std::vector<double> m_upper;
+    mutable std::vector<double> m_difference;
+    mutable std::size_t m_evaluationCounter;
+};
@@ -36,27 +36,50 @@
 #include <string>
 #include <tuple>
 
+#include "parallel/sharded_counter.h"
+
 // class representing the 108 multi-objective problems
 class MOBenchmark : public shark::MultiObjectiveFunction {
+   public:
+    // Full keeps U_i, A_i and H_i after construction. Compact keeps only
+    // A_i, which is all that eval() and nadir() read, and recomputes U_i
+    // and H_i from A_i and D_i when their accessors are first called
+    // (A_i = U_i diag(sqrt(D_i)), H_i = A_i A_i^T), so a large instance
+    // holds two instead of six n x n matrices.
+    enum class Storage { Full, Compact };
+
+    // How delta is obtained for the categories that take it from the
+    // generalised eigenproblem H_1 x = lambda H_2 x. Full forms
+    // H_2^{-1/2} H_1 H_2^{-1/2} and decomposes it completely, as the
+    // published instances were generated. Single works from the factors
+    // (H_i = A_i A_i^T, A_2^{-1} = diag(D_2)^{-1/2} U_2^T needs no
+    // inversion), tridiagonalises C C^T with C = A_2^{-1} A_1 and computes
+    // only the requested eigenpair by bisection and inverse iteration. It
+    // finds the same eigenvector up to sign and rounding, so instances can
+    // differ in the sign of delta.
+    enum class EigenSolver { Full, Single };
+
    private:
     std::string m_name;
     unsigned int m_dimension;
     unsigned int m_instance;
     double m_kappa;
+    Storage m_storage;
+    EigenSolver m_solver;
     double m_a1;
     double m_b1;
     shark::RealVector m_x1;
-    shark::RealMatrix m_U1;
+    mutable shark::RealMatrix m_U1;
     shark::RealVector m_D1;
     shark::RealMatrix m_A1;
-    shark::RealMatrix m_H1;
+    mutable shark::RealMatrix m_H1;
     double m_a2;
     double m_b2;
     shark::RealVector m_x2;
-    shark::RealMatrix m_U2;
+    mutable shark::RealMatrix m_U2;
     shark::RealVector m_D2;
     shark::RealMatrix m_A2;
-    shark::RealMatrix m_H2;
+    mutable shark::RealMatrix m_H2;
     shark::RealVector m_delta;
     double m_s;
     shark::BoxConstraintHandler<SearchPointType> m_handler;
@@ -65,6 +88,15 @@ class MOBenchmark : public shark::MultiObjectiveFunction {
     // solve U_1 diag(D_1) U_1^T x = \lambda U_2 diag(D_2) U_2^T x for x and \lambda
     static std::tuple<shark::RealMatrix, shark::RealVector> eig(shark::RealMatrix const& U1, shark::RealVector const& D1, shark::RealMatrix const& U2, shark::RealVector const& D2);
 
+    // eigenvector number index (eigenvalues in descending order) of the same problem, computed alone
+    static shark::RealVector eigenvector(shark::RealMatrix const& U1, shark::RealVector const& D1, shark::RealMatrix const& U2, shark::RealVector const& D2, unsigned int index);
+
+    // column index of the generalised eigenvectors of the current U_i, D_i with the configured solver
+    shark::RealVector generalizedEigenvector(unsigned int index) const;
+
+    // U = A diag(D)^{-1/2}, for compact storage
+    static shark::RealMatrix rotation(shark::RealMatrix const& A, shark::RealVector const& D);
+
     // construct a unit (identity) matrix
     static shark::RealMatrix eye(unsigned int n);
 
@@ -89,8 +121,12 @@ class MOBenchmark : public shark::MultiObjectiveFunction {
     // create ellipsoid diagonal with duplicate entry at u and v
     shark::RealVector createDdup(unsigned int u, unsigned int v);
 
+   protected:
+    // eval() of derived classes counts through here
+    void countEvaluation() const { incrementShared(m_evaluationCounter); }
+
    public:
-    MOBenchmark(std::string const& name, unsigned int dimension, unsigned int instance, double kappa = 1e3);
+    MOBenchmark(std::string const& name, unsigned int dimension, unsigned int instance, double kappa = 1e3, Storage storage = Storage::Full, EigenSolver solver = EigenSolver::Full);
 
     // Shark objective function interface
     std::string name() const override { return m_name; }
@@ -103,10 +139,13 @@ class MOBenchmark : public shark::MultiObjectiveFunction {
     // additional properties
     unsigned int instance() const { return m_instance; }
     double kappa() const { return m_kappa; }
+    Storage storage() const { return m_storage; }
+    EigenSolver eigenSolver() const { return m_solver; }
 
-    // central evaluation interface
+    // central evaluation interface; thread safe (the instance declares
+    // IS_THREAD_SAFE), it counts with incrementShared()
     ResultType eval(SearchPointType const& x) const override {
-        m_evaluationCounter++;
+        countEvaluation();
         shark::RealVector d1 = trans(m_A1) % (x - m_x1);
         shark::RealVector d2 = trans(m_A2) % (x - m_x2);
         return shark::RealVector{
@@ -134,16 +173,37 @@ class MOBenchmark : public shark::MultiObjectiveFunction {
 
     // The following data is provided only for evaluation purposes.
     // It must not be used by a black-box optimization algorithm.
+    // With compact storage the first call of U1() ... H2() materialises
+    // the matrix; this is not thread safe.
     shark::RealVector const& x1star() const { return m_x1; }
     shark::RealVector const& x2star() const { return m_x2; }
-    shark::RealMatrix const& U1() const { return m_U1; }
-    shark::RealMatrix const& U2() const { return m_U2; }
+    shark::RealMatrix const& U1() const {
+        if (m_U1.size1() != m_dimension) m_U1 = rotation(m_A1, m_D1);
+        return m_U1;
+    }
+    shark::RealMatrix const& U2() const {
+        if (m_U2.size1() != m_dimension) m_U2 = rotation(m_A2, m_D2);
+        return m_U2;
+    }
     shark::RealVector const& D1() const { return m_D1; }
     shark::RealVector const& D2() const { return m_D2; }
     shark::RealMatrix const& A1() const { return m_A1; }
     shark::RealMatrix const& A2() const { return m_A2; }
-    shark::RealMatrix const& H1() const { return m_H1; }
-    shark::RealMatrix const& H2() const { return m_H2; }
+    shark::RealMatrix const& H1() const {
+        if (m_H1.size1() != m_dimension) m_H1 = m_A1 % trans(m_A1);
+        return m_H1;
+    }
+    shark::RealMatrix const& H2() const {
+        if (m_H2.size1() != m_dimension) m_H2 = m_A2 % trans(m_A2);
+        return m_H2;
+    }
+    // objective i is 0.5 a_i (|A_i^T (x - x_i^*)|^2)^s + b_i
+    double a1() const { return m_a1; }
+    double a2() const { return m_a2; }
+    double b1() const { return m_b1; }
+    double b2() const { return m_b2; }
+    double s() const { return m_s; }
+    shark::BoxConstraintHandler<SearchPointType> const& constraints() const { return m_handler; }
     shark::RealVector utopian() const { return shark::RealVector{m_b1, m_b2}; }
     shark::RealVector nadir() const {
         shark::RealVector d1 = trans(m_A1) % m_delta;
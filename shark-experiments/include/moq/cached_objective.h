@@ -0,0 +1,67 @@
+/* cached_objective.h
+ *
+ * DESCRIPTION
+ * Objective function wrapper that memoises the values of another
+ * MultiObjectiveFunction in an EvaluationCache. Box constraint handling
+ * (the closest feasible point of MOBenchmark's handler) and the bounded
+ * operators of NSGA-II produce many bit-identical candidates at the
+ * bounds; their values are looked up instead of recomputed.
+ *
+ * Duplicates::Free does not charge cache hits to the evaluation budget, so
+ * a run sees only distinct points; Duplicates::Charged charges every call
+ * as the unwrapped function would and only saves the computation. The
+ * wrapper counts the charged evaluations in its own evaluationCounter()
+ * (the wrapped function counts only the misses) and is thread safe if the
+ * wrapped function is.
+ */
+#pragma once
+
+#include <shark/LinAlg/Base.h>
+#include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+
+#include <cstddef>
+#include <string>
+
+#include "parallel/evaluation_cache.h"
+#include "parallel/sharded_counter.h"
+
+class CachedObjective : public shark::MultiObjectiveFunction {
+   public:
+    enum class Duplicates { Free, Charged };
+
+    // function must outlive the wrapper
+    CachedObjective(shark::MultiObjectiveFunction const& function, std::size_t capacity, Duplicates duplicates = Duplicates::Free)
+        : m_function(function), m_duplicates(duplicates), m_cache(capacity, function.numberOfVariables(), function.numberOfObjectives()) {
+        if (function.hasConstraintHandler()) announceConstraintHandler(&function.getConstraintHandler());
+        if (function.canProposeStartingPoint()) m_features |= CAN_PROPOSE_STARTING_POINT;
+        if (function.isThreadSafe()) m_features |= IS_THREAD_SAFE;
+    }
+
+    std::string name() const override { return m_function.name(); }
+    std::size_t numberOfVariables() const override { return m_function.numberOfVariables(); }
+    std::size_t numberOfObjectives() const override { return m_function.numberOfObjectives(); }
+    SearchPointType proposeStartingPoint() const override { return m_function.proposeStartingPoint(); }
+    bool isFeasible(SearchPointType const& x) const override { return m_function.isFeasible(x); }
+    void closestFeasible(SearchPointType& x) const override { m_function.closestFeasible(x); }
+
+    ResultType eval(SearchPointType const& x) const override {
+        ResultType value(m_cache.objectives());
+        if (m_cache.find(&x(0), &value(0))) {
+            if (m_duplicates == Duplicates::Charged) incrementShared(m_evaluationCounter);
+            return value;
+        }
+        value = m_function.eval(x);
+        m_cache.insert(&x(0), &value(0));
+        incrementShared(m_evaluationCounter);
+        return value;
+    }
+
+    Duplicates duplicates() const { return m_duplicates; }
+    // hits are the duplicates, misses the distinct points
+    EvaluationCache const& cache() const { return m_cache; }
+
+   private:
+    shark::MultiObjectiveFunction const& m_function;
+    Duplicates m_duplicates;
+    mutable EvaluationCache m_cache;
+};
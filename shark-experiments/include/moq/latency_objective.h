@@ -0,0 +1,76 @@
+/* latency_objective.h
+ *
+ * DESCRIPTION
+ * Objective function wrapper that makes every evaluation of another
+ * MultiObjectiveFunction take a random amount of wall time, to study the
+ * scheduling of optimizers for expensive objectives (simulations taking
+ * milliseconds to seconds) with the cheap benchmark functions. The delay
+ * is drawn per call from a constant, log-normal or Pareto distribution and
+ * spent either sleeping (cheap, many evaluations can overlap on few cores)
+ * or spinning (occupies a core like real work would).
+ *
+ * The delays are a function of the call index: call i since construction
+ * or init() uses Philox block i of the configured seed, so a single-threaded run sees the same delays
+ * every time and threads never contend for a generator.
+ */
+#pragma once
+
+#include <shark/LinAlg/Base.h>
+#include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "parallel/sharded_counter.h"
+
+class LatencyObjective : public shark::MultiObjectiveFunction {
+   public:
+    // Constant: always median. LogNormal: median exp(shape N(0, 1)).
+    // Pareto: median (2 U)^{-1/shape} for U uniform in (0, 1], tail index
+    // shape (infinite variance for shape <= 2, infinite mean for shape <= 1).
+    enum class Distribution { Constant, LogNormal, Pareto };
+    enum class Wait { Sleep, Spin };
+
+    struct Latency {
+        Distribution distribution = Distribution::LogNormal;
+        // median delay in seconds
+        double median = 0.01;
+        // sigma of the log-normal or tail index of the Pareto distribution
+        double shape = 1.0;
+        Wait wait = Wait::Sleep;
+        std::uint64_t seed = 0;
+    };
+
+    // function must outlive the wrapper
+    LatencyObjective(shark::MultiObjectiveFunction const& function, Latency const& latency);
+
+    std::string name() const override { return m_function.name(); }
+    std::size_t numberOfVariables() const override { return m_function.numberOfVariables(); }
+    std::size_t numberOfObjectives() const override { return m_function.numberOfObjectives(); }
+    SearchPointType proposeStartingPoint() const override { return m_function.proposeStartingPoint(); }
+    bool isFeasible(SearchPointType const& x) const override { return m_function.isFeasible(x); }
+    void closestFeasible(SearchPointType& x) const override { m_function.closestFeasible(x); }
+
+    ResultType eval(SearchPointType const& x) const override;
+
+    // delay in seconds of call number index
+    double delay(std::uint64_t index) const;
+
+    void init() override {
+        shark::MultiObjectiveFunction::init();
+        m_calls.store(0, std::memory_order_relaxed);
+    }
+
+    Latency const& latency() const { return m_latency; }
+    // total delay injected so far, in seconds
+    double injectedSeconds() const { return m_injected.value() * 1e-9; }
+
+   private:
+    shark::MultiObjectiveFunction const& m_function;
+    Latency m_latency;
+    mutable std::atomic<std::uint64_t> m_calls;
+    // nanoseconds
+    mutable ShardedCounter m_injected;
+};
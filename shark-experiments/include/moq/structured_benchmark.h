@@ -0,0 +1,158 @@
+/* structured_benchmark.h
+ *
+ * DESCRIPTION
+ * The 54 problem classes of MOBenchmark (and its three shapes) with
+ * rotations that are never formed as dense matrices, for dimensions of
+ * 10^4 to 10^5. An ImplicitRotation is a permuted block-diagonal
+ * orthogonal matrix with blocks of size b times a product of k Householder
+ * reflectors. StructuredMOBenchmark uses either b > 1 and no
+ * reflectors (BlockDiagonal) or b = 1 and k reflectors (Householder), so
+ * storage and evaluation cost O(n b) or O(n k) instead of O(n^2), and
+ * construction needs no eigendecomposition.
+ *
+ * The classes keep their alignment semantics: aligned rotations leave the
+ * coordinate axis of the offset delta = x_2^* - x_1^* fixed, and in every
+ * class delta is a generalised eigenvector of (H_1, H_2), so the Pareto
+ * set is the segment between the optima. Where MOBenchmark takes delta
+ * from a dense generalised eigendecomposition (categories 5, 6 and 9) it
+ * is instead made a common eigenvector of H_1 and H_2 here, by one extra
+ * reflector that maps a column of the rotation onto delta. For category 6
+ * the rotated variant gets a duplicate eigenvalue in D_1 as in categories
+ * 2 to 4, so that delta does not have to be a coordinate axis. Instances
+ * are reproducible from (name, dimension, instance, structure, size) but
+ * differ from the dense MOBenchmark instances.
+ *
+ * REFERENCES
+ * - T. Glasmachers. Challenges of Convex Quadratic Bi-objective Benchmark
+ *   Problems. GECCO 2019.
+ * - A. S. Householder. Unitary Triangularization of a Nonsymmetric
+ *   Matrix. Journal of the ACM 5(4), 1958.
+ */
+#pragma once
+
+#include <shark/LinAlg/Base.h>
+#include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+#include <shark/ObjectiveFunctions/BoxConstraintHandler.h>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "parallel/sharded_counter.h"
+
+// U = B H_1 ... H_k with B = P^T diag(Q_1, ..., Q_m) P
+class ImplicitRotation {
+   public:
+    ImplicitRotation() : m_dimension(0) {}
+    // identity of dimension n
+    explicit ImplicitRotation(std::size_t n) : m_dimension(n) {}
+
+    // replaces B by a uniformly permuted block-diagonal matrix with Haar
+    // distributed blocks of size blockSize (the last one may be smaller);
+    // coordinate fix, if < n, becomes a 1 x 1 identity block
+    void sampleBlocks(std::size_t blockSize, std::mt19937& rng, std::size_t fix = static_cast<std::size_t>(-1));
+
+    // appends k reflectors with Gaussian directions, with a zero entry at
+    // coordinate fix if < n so that U e_fix = e_fix
+    void sampleReflectors(std::size_t k, std::mt19937& rng, std::size_t fix = static_cast<std::size_t>(-1));
+
+    // appends the reflector after which column p of U is the unit vector target
+    void alignColumn(std::size_t p, std::vector<double> const& target);
+
+    // out = U x and out = U^T x, out must not alias x
+    void apply(double const* x, double* out) const;
+    void applyTranspose(double const* x, double* out) const;
+
+    std::size_t dimension() const { return m_dimension; }
+    std::size_t numberOfBlocks() const { return m_blockStart.empty() ? 0 : m_blockStart.size() - 1; }
+    std::size_t numberOfReflectors() const { return m_reflectors.size() / (m_dimension ? m_dimension : 1); }
+
+   private:
+    // y = (I - 2 v v^T) y
+    void reflect(std::size_t r, double* y) const;
+
+    std::size_t m_dimension;
+    // block j acts on coordinates m_permutation[m_blockStart[j] ... m_blockStart[j + 1]),
+    // its row major entries start at m_blockOffset[j]; no blocks means B = I
+    std::vector<std::size_t> m_permutation;
+    std::vector<std::size_t> m_blockStart;
+    std::vector<std::size_t> m_blockOffset;
+    std::vector<double> m_blocks;
+    // unit vectors v_1 ... v_k, H_r = I - 2 v_r v_r^T
+    std::vector<double> m_reflectors;
+};
+
+class StructuredMOBenchmark : public shark::MultiObjectiveFunction {
+   public:
+    enum class Structure { BlockDiagonal, Householder };
+
+    // size is the block size b for BlockDiagonal and the number of reflectors k for Householder
+    StructuredMOBenchmark(std::string const& name, unsigned int dimension, unsigned int instance, Structure structure, unsigned int size, double kappa = 1e3);
+
+    // Shark objective function interface
+    std::string name() const override { return m_name; }
+    std::size_t numberOfVariables() const override { return m_dimension; }
+    bool hasScalableDimensionality() const override { return false; }
+    std::size_t numberOfObjectives() const override { return 2; }
+    bool hasScalableObjectives() const override { return false; }
+    SearchPointType proposeStartingPoint() const override { return shark::RealVector(m_dimension, 0.0); }
+    // thread safe like MOBenchmark::eval(), which see
+    ResultType eval(SearchPointType const& x) const override;
+
+    // additional properties
+    unsigned int instance() const { return m_instance; }
+    double kappa() const { return m_kappa; }
+    Structure structure() const { return m_structure; }
+
+    // The following data is provided only for evaluation purposes.
+    // It must not be used by a black-box optimization algorithm.
+    // objective i is 0.5 a_i (|diag(D_i)^{1/2} U_i^T (x - x_i^*)|^2)^s + b_i
+    shark::RealVector const& x1star() const { return m_x1; }
+    shark::RealVector const& x2star() const { return m_x2; }
+    shark::RealVector const& D1() const { return m_D1; }
+    shark::RealVector const& D2() const { return m_D2; }
+    ImplicitRotation const& U1() const { return m_U1; }
+    ImplicitRotation const& U2() const { return m_U2; }
+    double a1() const { return m_a1; }
+    double a2() const { return m_a2; }
+    double b1() const { return m_b1; }
+    double b2() const { return m_b2; }
+    double s() const { return m_s; }
+    shark::BoxConstraintHandler<SearchPointType> const& constraints() const { return m_handler; }
+    shark::RealVector utopian() const { return shark::RealVector{m_b1, m_b2}; }
+    shark::RealVector nadir() const;
+
+   private:
+    // |diag(D)^{1/2} U^T y|^2
+    static double quadraticForm(ImplicitRotation const& U, shark::RealVector const& D, double const* y, double* buffer);
+
+    // a rotation of the configured structure, leaving coordinate fix in place if < n
+    ImplicitRotation sampleRotation(std::size_t fix = static_cast<std::size_t>(-1));
+
+    // as in MOBenchmark
+    std::vector<double> gauss(unsigned int n);
+    shark::RealVector createD();
+    shark::RealVector createDdup(unsigned int u, unsigned int v);
+
+    std::string m_name;
+    unsigned int m_dimension;
+    unsigned int m_instance;
+    Structure m_structure;
+    unsigned int m_size;
+    double m_kappa;
+    double m_a1;
+    double m_b1;
+    shark::RealVector m_x1;
+    shark::RealVector m_D1;
+    ImplicitRotation m_U1;
+    double m_a2;
+    double m_b2;
+    shark::RealVector m_x2;
+    shark::RealVector m_D2;
+    ImplicitRotation m_U2;
+    std::vector<double> m_delta;
+    double m_s;
+    shark::BoxConstraintHandler<SearchPointType> m_handler;
+    std::mt19937 m_rng;
+};
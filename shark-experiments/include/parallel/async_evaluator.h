@@ -0,0 +1,80 @@
+/* async_evaluator.h
+ *
+ * DESCRIPTION
+ * Worker threads that evaluate search points in the background, for
+ * drivers that keep several evaluations of an expensive objective in
+ * flight. submit() queues a point and returns at once; next() returns the
+ * evaluations in the order they finish, waiting only if none has. A
+ * driver that submits a new point whenever next() returns keeps every
+ * worker busy regardless of how much the evaluation times vary; one that
+ * submits a batch and collects all of it idles the workers on the slowest
+ * evaluation of the batch.
+ *
+ * Objective functions that are not thread safe are evaluated under a lock,
+ * so at most one of them runs at a time.
+ */
+#pragma once
+
+#include <shark/LinAlg/Base.h>
+#include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class AsyncEvaluator {
+   public:
+    struct Result {
+        // as passed to submit()
+        std::size_t ticket;
+        shark::RealVector point;
+        shark::RealVector value;
+    };
+
+    // function must outlive the evaluator
+    AsyncEvaluator(shark::MultiObjectiveFunction const& function, std::size_t workers);
+    ~AsyncEvaluator();
+
+    AsyncEvaluator(AsyncEvaluator const&) = delete;
+    AsyncEvaluator& operator=(AsyncEvaluator const&) = delete;
+
+    void submit(std::size_t ticket, shark::RealVector const& point);
+    // the next evaluation to finish; an exception thrown by eval() is
+    // rethrown here, and calling it with nothing in flight throws
+    Result next();
+
+    // submitted and not yet returned by next()
+    std::size_t inFlight() const;
+    std::size_t workers() const { return m_threads.size(); }
+    // seconds spent in eval(), summed over the workers
+    double busySeconds() const;
+    // seconds next() waited for an evaluation to finish
+    double waitSeconds() const;
+
+   private:
+    struct Finished {
+        Result result;
+        std::exception_ptr error;
+    };
+
+    void work();
+
+    shark::MultiObjectiveFunction const& m_function;
+    bool m_threadSafe;
+    std::mutex m_evalMutex;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_submitted;
+    std::condition_variable m_finished;
+    std::deque<Result> m_queue;
+    std::deque<Finished> m_done;
+    std::size_t m_inFlight;
+    double m_busy;
+    double m_wait;
+    bool m_stop;
+    std::vector<std::thread> m_threads;
+};
@@ -0,0 +1,72 @@
+/* evaluation_cache.h
+ *
+ * DESCRIPTION
+ * Bounded, lock-free map from search points to objective values, keyed on
+ * the raw bytes of the point (so 0.0 and -0.0 are different keys). The
+ * table is set associative: a point hashes to a set of WAYS slots, is
+ * stored in a free slot of the set or replaces one of them, so memory stays
+ * at capacity slots however many points are inserted.
+ *
+ * Every slot is guarded by a sequence number (a seqlock): a writer claims
+ * the slot by making the number odd, writes, and makes it even again; a
+ * reader copies the slot and keeps the copy only if the number was even and
+ * unchanged around the copy. Readers never block, and an insert that finds
+ * its slot being written by another thread is dropped. Slot words are
+ * relaxed atomics, which compile to plain loads and stores.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "parallel/sharded_counter.h"
+
+class EvaluationCache {
+   public:
+    static constexpr std::size_t WAYS = 4;
+
+    // capacity is rounded up to a power of two of at least WAYS slots,
+    // keys have dimension entries and values objectives entries
+    EvaluationCache(std::size_t capacity, std::size_t dimension, std::size_t objectives);
+
+    EvaluationCache(EvaluationCache const&) = delete;
+    EvaluationCache& operator=(EvaluationCache const&) = delete;
+
+    // copies the value stored for x to value and returns true, or returns
+    // false (value may have been written to)
+    bool find(double const* x, double* value) const;
+    // stores the value of x, replacing another point of its set if the set is full
+    void insert(double const* x, double const* value);
+    // forgets all points and statistics, not to be called concurrently
+    void clear();
+
+    std::size_t capacity() const { return m_sets * WAYS; }
+    std::size_t dimension() const { return m_dimension; }
+    std::size_t objectives() const { return m_objectives; }
+
+    // statistics since construction or clear()
+    std::size_t hits() const { return m_hits.value(); }
+    std::size_t misses() const { return m_misses.value(); }
+    std::size_t insertions() const { return m_insertions.value(); }
+    std::size_t evictions() const { return m_evictions.value(); }
+
+   private:
+    typedef std::atomic<std::uint64_t> Word;
+
+    // slot layout: sequence number, hash, dimension key words, objectives value words
+    Word* slot(std::size_t index) const { return m_words.get() + index * m_stride; }
+    std::uint64_t hash(double const* x) const;
+
+    std::size_t m_dimension;
+    std::size_t m_objectives;
+    std::size_t m_sets;
+    std::size_t m_stride;
+    std::unique_ptr<Word[]> m_words;
+
+    mutable ShardedCounter m_hits;
+    mutable ShardedCounter m_misses;
+    ShardedCounter m_insertions;
+    ShardedCounter m_evictions;
+};
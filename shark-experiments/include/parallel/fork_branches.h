@@ -0,0 +1,30 @@
+/* fork_branches.h
+ *
+ * DESCRIPTION
+ * Runs several continuations of the current state of this process, each in
+ * a child made with fork(). A child starts from a copy-on-write image of
+ * the parent at the moment of the fork, so a long shared prefix (e.g. an
+ * optimizer after 50,000 evaluations) is computed once, and every branch
+ * only pays for the pages it changes. A branch writes its report to a
+ * std::ostream; the child sends the report to the parent through a pipe
+ * and leaves with _exit(), so no destructors or atexit handlers of the
+ * parent run twice. The parent reads all pipes as the children write and
+ * returns the reports in branch order. At most `parallel` children run at
+ * once.
+ *
+ * fork() copies only the calling thread: no other thread of the process may
+ * be running, or holding a lock, when forkBranches() is called. Pending
+ * output of the standard streams is flushed before forking, so it does not
+ * appear twice. POSIX only.
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// calls branch(i, report) for every i < branches in a child process;
+// parallel = 0 uses one child per hardware thread; throws if a child fails
+std::vector<std::string> forkBranches(std::size_t branches, std::function<void(std::size_t, std::ostream&)> const& branch, std::size_t parallel = 0);
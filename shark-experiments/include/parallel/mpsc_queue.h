@@ -0,0 +1,81 @@
+/* mpsc_queue.h
+ *
+ * DESCRIPTION
+ * Unbounded lock-free queue for many producers and a single consumer, the
+ * mailbox of an island in IslandModel. push() is wait-free: one exchange on
+ * the head and one store into the previous node. pop() never blocks either;
+ * it returns false while the queue is empty, and also in the short window
+ * in which a producer has swung the head but not yet linked the previous
+ * node. The value then shows up on a later call. A mailbox polled every
+ * few generations only picks up a migration late, it never loses one.
+ *
+ * Values are moved into heap nodes by the producers and freed by the
+ * consumer; the destructor frees whatever was not consumed. T has to be
+ * default constructible for the stub node.
+ *
+ * REFERENCES
+ * - D. Vyukov. Intrusive MPSC node-based queue. 1024cores.net, 2010.
+ */
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+template <typename T>
+class MPSCQueue {
+   public:
+    MPSCQueue() : m_head(&m_stub), m_tail(&m_stub) {}
+    ~MPSCQueue() {
+        T value;
+        while (pop(value)) {
+        }
+    }
+    MPSCQueue(MPSCQueue const&) = delete;
+    MPSCQueue& operator=(MPSCQueue const&) = delete;
+
+    // any thread
+    void push(T value) { link(new Node(std::move(value))); }
+
+    // consumer thread only
+    bool pop(T& value) {
+        Node* tail = m_tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (tail == &m_stub) {
+            if (!next) return false;
+            m_tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (!next) {
+            // tail is the last node, unless a push is in progress
+            if (tail != m_head.load(std::memory_order_acquire)) return false;
+            // put the stub behind it so that tail can be unlinked
+            link(&m_stub);
+            next = tail->next.load(std::memory_order_acquire);
+            if (!next) return false;
+        }
+        m_tail = next;
+        value = std::move(tail->value);
+        delete tail;
+        return true;
+    }
+
+   private:
+    struct Node {
+        Node() {}
+        explicit Node(T&& v) : value(std::move(v)) {}
+        std::atomic<Node*> next{nullptr};
+        T value;
+    };
+
+    void link(Node* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        Node* previous = m_head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    // producers and consumer on separate cache lines
+    alignas(64) std::atomic<Node*> m_head;
+    alignas(64) Node* m_tail;
+    Node m_stub;
+};
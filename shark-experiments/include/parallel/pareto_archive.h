@@ -0,0 +1,156 @@
+/* pareto_archive.h
+ *
+ * DESCRIPTION
+ * Archive of the non-dominated solutions of a bi-objective run that many
+ * threads feed at once: islands, the workers of an asynchronous
+ * optimizer, parallel trials. The archive is a front sorted by increasing
+ * first (so decreasing second) objective. A value is weakly dominated by
+ * the front iff its predecessor in that order is no worse in the second
+ * objective, a binary search.
+ *
+ * Versions of the front are immutable and published RCU style: insert()
+ * builds the next version under a writer mutex and swaps it in with an
+ * atomic shared_ptr store, and snapshot() loads the current version
+ * without taking the mutex. A snapshot stays valid and unchanged however
+ * long it is used; writers never wait for readers, and readers never wait
+ * for a writer's copy. The front is a sequence of chunks of up to
+ * 2 * CHUNK members that versions share: a new version copies the chunk
+ * pointers and rebuilds only the chunks it changes, so an insert costs
+ * O(n / CHUNK + CHUNK) instead of a copy of the front. Most candidates of a
+ * running optimizer are dominated, and those are rejected on a snapshot
+ * without touching the mutex.
+ *
+ * With a capacity, a front that grows beyond it drops the member with the
+ * smallest hypervolume contribution; the two extreme members are never
+ * dropped. Points dominated by a dropped member can then enter again, as
+ * in any bounded archive.
+ */
+#pragma once
+
+#include <shark/LinAlg/Base.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "parallel/sharded_counter.h"
+
+class ParetoArchive2D {
+   public:
+    static constexpr std::size_t CHUNK = 64;
+
+    // same members as the solutions of Shark's optimizers
+    struct Solution {
+        shark::RealVector point;
+        shark::RealVector value;
+    };
+
+    // one version of the front, sorted by increasing first objective
+    class Snapshot {
+       public:
+        std::size_t size() const { return m_front->offsets.back(); }
+        bool empty() const { return size() == 0; }
+        Solution const& operator[](std::size_t i) const { return *member(i).solution; }
+        double value(std::size_t i, std::size_t k) const { return member(i).value[k]; }
+        // number of versions published before this one
+        std::uint64_t version() const { return m_front->version; }
+        // true if a member is at least as good in both objectives
+        bool dominates(double f0, double f1) const;
+
+       private:
+        friend class ParetoArchive2D;
+        struct Member {
+            double value[2];
+            std::shared_ptr<Solution const> solution;
+        };
+        // consecutive members; chunks are never modified once published
+        struct Chunk {
+            std::vector<Member> members;
+        };
+        struct Front {
+            std::vector<std::shared_ptr<Chunk const>> chunks;
+            // first objective of the first member of every chunk
+            std::vector<double> firsts;
+            // members before every chunk, and the size at the end
+            std::vector<std::size_t> offsets{0};
+            std::uint64_t version = 0;
+        };
+        explicit Snapshot(std::shared_ptr<Front const> front) : m_front(std::move(front)) {}
+        Member const& member(std::size_t i) const { return at(*m_front, i); }
+        static Member const& at(Front const& front, std::size_t i);
+        // chunk of member i, the last chunk for i == size
+        static std::size_t chunkOf(Front const& front, std::size_t i);
+        // first member whose first objective is not less than f0
+        static std::size_t lowerBound(Front const& front, double f0);
+
+        std::shared_ptr<Front const> m_front;
+    };
+
+    // capacity 0 keeps every non-dominated solution
+    explicit ParetoArchive2D(std::size_t capacity = 0);
+
+    ParetoArchive2D(ParetoArchive2D const&) = delete;
+    ParetoArchive2D& operator=(ParetoArchive2D const&) = delete;
+
+    std::size_t capacity() const { return m_capacity; }
+
+    // true if the solution joined the front (and survived pruning)
+    bool insert(shark::RealVector const& point, shark::RealVector const& value);
+    // all solutions with one new version, returns how many joined
+    template <typename Solutions>
+    std::size_t insert(Solutions const& solutions);
+
+    Snapshot snapshot() const;
+    bool dominates(shark::RealVector const& value) const { return snapshot().dominates(value(0), value(1)); }
+    std::size_t size() const { return snapshot().size(); }
+    void clear();
+
+    // candidates that joined, were rejected as dominated, or were pruned
+    std::size_t accepted() const { return m_accepted.value(); }
+    std::size_t rejected() const { return m_rejected.value(); }
+    std::size_t pruned() const { return m_pruned.value(); }
+
+   private:
+    typedef Snapshot::Member Member;
+    typedef Snapshot::Front Front;
+
+    // publishes one version with the candidates, which the current one did
+    // not dominate when they were made
+    std::size_t insertCandidates(std::vector<Member>& candidates);
+    typedef Snapshot::Chunk Chunk;
+
+    // adds candidate to front, which is not shared yet; false if dominated
+    static bool merge(Front& front, Member const& candidate);
+    // replaces members [first, last) of front by candidate, if any
+    static void splice(Front& front, std::size_t first, std::size_t last, Member const* candidate);
+    // drops least contributors down to the capacity
+    void prune(Front& front);
+
+    std::size_t m_capacity;
+    // read with std::atomic_load, written with std::atomic_store
+    std::shared_ptr<Front const> m_current;
+    std::mutex m_writer;
+    ShardedCounter m_accepted;
+    ShardedCounter m_rejected;
+    ShardedCounter m_pruned;
+    // values of the front for prune(), guarded by m_writer
+    std::vector<double> m_values;
+};
+
+template <typename Solutions>
+std::size_t ParetoArchive2D::insert(Solutions const& solutions) {
+    // drop what the current version already dominates before locking
+    Snapshot current = snapshot();
+    std::vector<Member> candidates;
+    for (auto const& s : solutions) {
+        if (current.dominates(s.value(0), s.value(1))) {
+            m_rejected.increment();
+            continue;
+        }
+        candidates.push_back(Member{{s.value(0), s.value(1)}, std::make_shared<Solution const>(Solution{s.point, s.value})});
+    }
+    if (candidates.empty()) return 0;
+    return insertCandidates(candidates);
+}
@@ -0,0 +1,116 @@
+/* prefetcher.h
+ *
+ * DESCRIPTION
+ * Bounded producer/consumer pipeline for objects that are expensive to
+ * build and consumed in a fixed order, such as benchmark instances. Items
+ * 0, ..., count - 1 are built by factory(i) on background threads while
+ * the caller works on earlier ones; next() hands them out in index order
+ * and only blocks if the item is not finished yet. At most capacity items
+ * are built or waiting to be taken at any time, which bounds the memory
+ * held by the pipeline to capacity items plus the ones the caller owns.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+template <class T>
+class Prefetcher {
+   public:
+    typedef std::function<std::unique_ptr<T>(std::size_t)> Factory;
+
+    Prefetcher(std::size_t count, Factory factory, std::size_t capacity, std::size_t threads = 1)
+        : m_factory(std::move(factory)), m_count(count), m_capacity(capacity ? capacity : 1), m_claimed(0), m_consumed(0), m_waits(0), m_stop(false),
+          m_items(m_capacity), m_errors(m_capacity), m_filled(m_capacity, 0) {
+        for (std::size_t t = 0; t < (threads ? threads : 1); t++) m_threads.emplace_back(&Prefetcher::produce, this);
+    }
+
+    ~Prefetcher() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_space.notify_all();
+        for (auto& thread : m_threads) thread.join();
+    }
+
+    Prefetcher(Prefetcher const&) = delete;
+    Prefetcher& operator=(Prefetcher const&) = delete;
+
+    // Item number i for the i-th call, waiting for it if necessary. An
+    // exception thrown by the factory for this item is rethrown here.
+    std::unique_ptr<T> next() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_consumed == m_count) throw std::runtime_error("Prefetcher: all items have been taken.");
+        std::size_t slot = m_consumed % m_capacity;
+        if (!m_filled[slot]) {
+            m_waits++;
+            m_ready.wait(lock, [&] { return m_filled[slot] != 0; });
+        }
+        std::unique_ptr<T> item = std::move(m_items[slot]);
+        std::exception_ptr error = m_errors[slot];
+        m_errors[slot] = nullptr;
+        m_filled[slot] = 0;
+        m_consumed++;
+        lock.unlock();
+        m_space.notify_one();
+        if (error) std::rethrow_exception(error);
+        return item;
+    }
+
+    // number of next() calls that had to wait for their item
+    std::size_t waits() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_waits;
+    }
+
+   private:
+    void produce() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true) {
+            m_space.wait(lock, [&] { return m_stop || m_claimed == m_count || m_claimed < m_consumed + m_capacity; });
+            if (m_stop || m_claimed == m_count) return;
+            std::size_t i = m_claimed++;
+            lock.unlock();
+            std::unique_ptr<T> item;
+            std::exception_ptr error;
+            try {
+                item = m_factory(i);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            std::size_t slot = i % m_capacity;
+            m_items[slot] = std::move(item);
+            m_errors[slot] = error;
+            m_filled[slot] = 1;
+            m_ready.notify_all();
+        }
+    }
+
+    Factory m_factory;
+    std::size_t m_count;
+    std::size_t m_capacity;
+    // next index to build and next index to hand out
+    std::size_t m_claimed;
+    std::size_t m_consumed;
+    std::size_t m_waits;
+    bool m_stop;
+
+    // item i lives in slot i % capacity between being built and taken
+    std::vector<std::unique_ptr<T>> m_items;
+    std::vector<std::exception_ptr> m_errors;
+    std::vector<char> m_filled;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_ready;
+    std::condition_variable m_space;
+    std::vector<std::thread> m_threads;
+};
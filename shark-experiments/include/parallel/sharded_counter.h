@@ -0,0 +1,80 @@
+/* sharded_counter.h
+ *
+ * DESCRIPTION
+ * Event counter for objects that are shared by threads, such as the
+ * evaluation counter of an objective function evaluated from a thread
+ * pool. A single atomic would bounce its cache line between all cores on
+ * every increment; here every thread increments its own shard (a
+ * relaxed, uncontended atomic on a cache line of its own) and value() sums
+ * the shards. The sum is exact whenever the increments it should see
+ * happen before the read, e.g. after ThreadPool::parallelFor() returned.
+ *
+ * Threads are assigned shards round robin in the order they first
+ * increment any counter; with more threads than shards some share one,
+ * which only costs speed.
+ *
+ * A counter that other code reads as a plain std::size_t cannot be
+ * sharded. Shark's objective functions are such a case: their
+ * evaluationCounter() is not virtual and returns m_evaluationCounter, so
+ * objective functions that are evaluated concurrently count there with
+ * incrementShared(), a relaxed atomic increment of the plain member.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// thread safe counter += n for a counter that is read without atomics, such
+// as Shark's m_evaluationCounter; exact whenever the increments it should
+// see happen before the read
+inline void incrementShared(std::size_t& counter, std::size_t n = 1) { __atomic_fetch_add(&counter, n, __ATOMIC_RELAXED); }
+
+class ShardedCounter {
+   public:
+    static constexpr std::size_t SHARDS = 64;
+
+    ShardedCounter() { reset(); }
+
+    // copies hold the current value in their first shard
+    ShardedCounter(ShardedCounter const& other) {
+        reset();
+        m_shards[0].value.store(other.value(), std::memory_order_relaxed);
+    }
+    ShardedCounter& operator=(ShardedCounter const& other) {
+        std::size_t value = other.value();
+        reset();
+        m_shards[0].value.store(value, std::memory_order_relaxed);
+        return *this;
+    }
+
+    void increment(std::size_t n = 1) { m_shards[shard()].value.fetch_add(n, std::memory_order_relaxed); }
+    ShardedCounter& operator++() {
+        increment();
+        return *this;
+    }
+
+    std::size_t value() const {
+        std::size_t ret = 0;
+        for (Shard const& s : m_shards) ret += s.value.load(std::memory_order_relaxed);
+        return ret;
+    }
+
+    // not to be called while other threads increment
+    void reset() {
+        for (Shard& s : m_shards) s.value.store(0, std::memory_order_relaxed);
+    }
+
+   private:
+    struct alignas(64) Shard {
+        std::atomic<std::size_t> value;
+    };
+
+    // shard of the calling thread, the same for all counters
+    static std::size_t shard() {
+        static std::atomic<std::size_t> threads(0);
+        thread_local std::size_t index = threads.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+        return index;
+    }
+
+    Shard m_shards[SHARDS];
+};
@@ -0,0 +1,56 @@
+/* thread_pool.h
+ *
+ * DESCRIPTION
+ * Fixed set of worker threads for fork-join loops inside a single
+ * optimizer step. parallelFor() hands out indices in small chunks from a
+ * shared counter; the calling thread works as worker 0, so a pool of size
+ * one runs everything inline without touching a lock.
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+   public:
+    // threads counts the calling thread, 0 means one per hardware thread
+    explicit ThreadPool(std::size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    std::size_t size() const { return m_workers.size() + 1; }
+
+    // Calls body(i, worker) for every i in [0, n) and returns when all calls
+    // are done. worker is in [0, size()) and unique among concurrently
+    // running calls, so it can index per-thread scratch space. The first
+    // exception thrown by body is rethrown here.
+    void parallelFor(std::size_t n, std::function<void(std::size_t, std::size_t)> const& body, std::size_t chunk = 1);
+
+   private:
+    void run(std::size_t worker);
+    void work(std::size_t worker);
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_finish;
+    std::uint64_t m_generation;
+    std::size_t m_active;
+    bool m_stop;
+
+    // current loop, valid while m_active > 0
+    std::function<void(std::size_t, std::size_t)> const* m_body;
+    std::size_t m_n;
+    std::size_t m_chunk;
+    std::atomic<std::size_t> m_next;
+    std::exception_ptr m_error;
+};
@@ -0,0 +1,57 @@
+/* plot_queue.h
+ *
+ * DESCRIPTION
+ * Hands plot specs to a persistent out-of-process renderer
+ * (scripts/plot_worker.py) through a spool directory. submit() only moves
+ * the spec into an in-memory queue; a background thread writes it as a
+ * binary array file plus a small text spec, and publishes the spec with an
+ * atomic rename. No Python runs inside the calling process, and any number
+ * of experiments can share one worker.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "plotting/plot_spec.h"
+
+class PlotQueue {
+   public:
+    // At most capacity specs wait for the writer thread before submit()
+    // blocks, which bounds the memory held by queued arrays.
+    explicit PlotQueue(std::string const& spoolDirectory, std::size_t capacity = 64);
+
+    // waits until every submitted spec has been published
+    ~PlotQueue();
+
+    PlotQueue(PlotQueue const&) = delete;
+    PlotQueue& operator=(PlotQueue const&) = delete;
+
+    void submit(PlotSpec spec);
+
+    // block until all submitted specs have been published
+    void flush();
+
+    std::string const& spoolDirectory() const { return m_directory; }
+
+   private:
+    void run();
+    void publish(PlotSpec const& spec);
+
+    std::string m_directory;
+    std::size_t m_capacity;
+    std::deque<PlotSpec> m_pending;
+    std::uint64_t m_submitted;
+    std::uint64_t m_published;
+    bool m_stop;
+    std::exception_ptr m_error;
+    std::mutex m_mutex;
+    std::condition_variable m_work;
+    std::condition_variable m_done;
+    std::thread m_writer;
+};
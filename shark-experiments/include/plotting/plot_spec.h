@@ -0,0 +1,71 @@
+/* plot_spec.h
+ *
+ * DESCRIPTION
+ * Backend independent description of a figure made of line/marker series,
+ * e.g. the population plots of experiment0. Formats use the matplotlib
+ * shorthand ("xb", "r-", ...).
+ *
+ * The coordinates of a series are strided views that share ownership of
+ * their buffer, so a series can refer to the columns of a population
+ * matrix and be handed to any backend (including NumPy) without copying.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+class PlotColumn {
+   public:
+    PlotColumn() : m_data(nullptr), m_size(0), m_stride(1) {}
+
+    // takes over the vector, no copy
+    PlotColumn(std::vector<double> values) {
+        auto owner = std::make_shared<std::vector<double> const>(std::move(values));
+        m_data = owner->data();
+        m_size = owner->size();
+        m_stride = 1;
+        m_owner = std::move(owner);
+    }
+
+    // size elements starting at data, stride elements apart; owner keeps
+    // the buffer alive for as long as the view (or a NumPy array made from
+    // it) exists
+    PlotColumn(std::shared_ptr<void const> owner, double const* data, std::size_t size, std::ptrdiff_t stride = 1)
+        : m_owner(std::move(owner)), m_data(data), m_size(size), m_stride(stride) {}
+
+    std::size_t size() const { return m_size; }
+    std::ptrdiff_t stride() const { return m_stride; }
+    bool contiguous() const { return m_stride == 1; }
+    double const* data() const { return m_data; }
+    std::shared_ptr<void const> const& owner() const { return m_owner; }
+
+    double operator[](std::size_t i) const { return m_data[static_cast<std::ptrdiff_t>(i) * m_stride]; }
+
+   private:
+    std::shared_ptr<void const> m_owner;
+    double const* m_data;
+    std::size_t m_size;
+    std::ptrdiff_t m_stride;
+};
+
+struct PlotSeries {
+    PlotColumn x;
+    PlotColumn y;
+    std::string format;
+};
+
+struct PlotSpec {
+    // size in pixels
+    long width = 500;
+    long height = 350;
+    std::string title;
+    std::string filename;
+    std::vector<PlotSeries> series;
+
+    void plot(PlotColumn x, PlotColumn y, std::string format = "") {
+        series.push_back(PlotSeries{std::move(x), std::move(y), std::move(format)});
+    }
+};
@@ -0,0 +1,59 @@
+/* raster.h
+ *
+ * DESCRIPTION
+ * Small native plotting backend for quick-look population plots. Draws the
+ * series of a PlotSpec (markers, lines, axes with ticks, title) into an
+ * RGBA buffer and writes PNG, or emits the same figure as SVG, without
+ * Python. Only the subset of the matplotlib format shorthand used by the
+ * experiments is understood: colors "bgrcmykw", markers "x+o.,s" and the
+ * line styles "-" and "--".
+ *
+ * REFERENCES
+ * - https://www.w3.org/TR/png/
+ * - https://www.rfc-editor.org/rfc/rfc1951 (fixed Huffman deflate)
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "plotting/plot_spec.h"
+
+struct RGBA {
+    std::uint8_t r, g, b, a;
+};
+
+class RasterCanvas {
+   public:
+    RasterCanvas(std::size_t width, std::size_t height, RGBA background = RGBA{255, 255, 255, 255});
+
+    std::size_t width() const { return m_width; }
+    std::size_t height() const { return m_height; }
+    std::uint8_t const* data() const { return m_pixels.data(); }
+
+    void clear(RGBA color);
+    void pixel(long x, long y, RGBA color);
+    void fill(long x0, long y0, long x1, long y1, RGBA color);
+    // dash > 0 draws dash pixels on and dash pixels off
+    void line(long x0, long y0, long x1, long y1, RGBA color, unsigned int dash = 0);
+    void marker(char shape, long x, long y, long radius, RGBA color);
+    // 3x5 pixel font scaled by scale, lowercase letters are drawn as capitals
+    void text(std::string const& text, long x, long y, RGBA color, long scale = 1);
+    static long textWidth(std::string const& text, long scale = 1);
+
+    void writePNG(std::string const& filename) const;
+
+   private:
+    std::size_t m_width;
+    std::size_t m_height;
+    std::vector<std::uint8_t> m_pixels;
+};
+
+// draw the figure into a canvas of the spec's size
+RasterCanvas rasterize(PlotSpec const& spec);
+
+void writeSVG(PlotSpec const& spec, std::string const& filename);
+
+// write spec.filename as SVG if it ends in ".svg" and as PNG otherwise
+void renderNative(PlotSpec const& spec);
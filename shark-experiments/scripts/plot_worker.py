@@ -0,0 +1,122 @@
+"""Render plot specs spooled by the C++ experiments.
+
+The experiments publish ``*.spec`` files (see ``plotting/plot_queue.h``)
+into a spool directory. This worker keeps one interpreter with matplotlib
+loaded, renders the specs in batches and removes them once the figure has
+been saved. Specs that fail to render are moved to ``failed/``.
+
+Usage: python3 plot_worker.py SPOOL_DIR [--once] [--batch N] [--poll S]
+"""
+import argparse
+import pathlib
+import shutil
+import sys
+import time
+
+import matplotlib
+
+matplotlib.use("Agg")
+
+import matplotlib.pyplot as plt  # noqa: E402
+import numpy as np  # noqa: E402
+
+DPI = 100.0
+
+
+def unescape(text):
+    """Undo the escaping of newlines and backslashes in titles."""
+    out = []
+    i = 0
+    while i < len(text):
+        if text[i] == "\\" and i + 1 < len(text):
+            out.append("\n" if text[i + 1] == "n" else text[i + 1])
+            i += 2
+        else:
+            out.append(text[i])
+            i += 1
+    return "".join(out)
+
+
+def parse(path):
+    """Parse a spec file into a dictionary."""
+    spec = {"title": "", "series": []}
+    for line in path.read_text().splitlines():
+        key, _, value = line.partition(" ")
+        if key == "version" and value != "1":
+            raise ValueError("unsupported spec version " + value)
+        elif key == "size":
+            width, height = value.split()
+            spec["size"] = (int(width), int(height))
+        elif key == "title":
+            spec["title"] = unescape(value)
+        elif key == "output":
+            spec["output"] = value
+        elif key == "data":
+            spec["data"] = path.parent / value
+        elif key == "series":
+            length, _, fmt = value.partition(" ")
+            spec["series"].append((int(length), fmt))
+    return spec
+
+
+def render(spec):
+    """Render one parsed spec to its output file."""
+    data = np.fromfile(spec["data"], dtype=np.float64)
+    width, height = spec["size"]
+    fig = plt.figure(figsize=(width / DPI, height / DPI), dpi=DPI)
+    offset = 0
+    for length, fmt in spec["series"]:
+        x = data[offset:offset + length]
+        y = data[offset + length:offset + 2 * length]
+        offset += 2 * length
+        plt.plot(x, y, fmt)
+    if offset != data.size:
+        raise ValueError("array file does not match the spec")
+    plt.title(spec["title"])
+    fig.savefig(spec["output"])
+    plt.close(fig)
+
+
+def drain(spool, batch):
+    """Render up to `batch` pending specs, returns the number handled."""
+    pending = sorted(spool.glob("*.spec"), key=lambda p: p.stat().st_mtime)
+    for path in pending[:batch]:
+        data = path.with_suffix(".bin")
+        try:
+            render(parse(path))
+        except Exception as error:  # keep serving the other experiments
+            print("failed to render {}: {}".format(path, error),
+                  file=sys.stderr)
+            failed = spool / "failed"
+            failed.mkdir(exist_ok=True)
+            for f in (path, data):
+                if f.exists():
+                    shutil.move(str(f), str(failed / f.name))
+            continue
+        path.unlink()
+        if data.exists():
+            data.unlink()
+    return min(len(pending), batch)
+
+
+def main():
+    """Run the worker loop."""
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("spool", type=pathlib.Path)
+    parser.add_argument("--once", action="store_true",
+                        help="render the pending specs and exit")
+    parser.add_argument("--batch", type=int, default=64)
+    parser.add_argument("--poll", type=float, default=0.2)
+    args = parser.parse_args()
+
+    args.spool.mkdir(parents=True, exist_ok=True)
+    while True:
+        handled = drain(args.spool, args.batch)
+        if args.once and handled == 0:
+            break
+        if handled == 0:
+            time.sleep(args.poll)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,179 @@
+/* async_steady_state_mocma.cpp
+ *
+ * DESCRIPTION
+ * Submission and integration of offspring for AsyncSteadyStateMOCMA. The
+ * slot of an offspring is its ticket in the AsyncEvaluator; births tell a
+ * parent that is still alive from a slot that has been reused.
+ *
+ * REFERENCES
+ * - [Igel 2007b] C. Igel, T. Suttorp and N. Hansen. Steady-state Selection
+ *   and Efficient Covariance Matrix Update in the Multi-objective CMA-ES.
+ *   EMO 2007.
+ */
+#include "algorithms/async_steady_state_mocma.h"
+
+#include <shark/Core/Random.h>
+
+#include <random>
+#include <stdexcept>
+
+using namespace shark;
+
+AsyncSteadyStateMOCMA::AsyncSteadyStateMOCMA()
+    : m_mu(100), m_initialSigma(1.0), m_notionOfSuccess(NotionOfSuccess::PopulationBased), m_parallelism(4), m_workers(0), m_penaltyFactor(1e-6), m_births(0), m_function(nullptr) {}
+
+AsyncSteadyStateMOCMA::~AsyncSteadyStateMOCMA() {}
+
+void AsyncSteadyStateMOCMA::init(ObjectiveFunctionType const& function) {
+    std::vector<SearchPointType> points(m_mu);
+    for (auto& point : points) point = function.proposeStartingPoint();
+    init(function, points);
+}
+
+void AsyncSteadyStateMOCMA::init(ObjectiveFunctionType const& function, std::vector<SearchPointType> const& initialSearchPoints) {
+    if (initialSearchPoints.empty()) {
+        throw std::runtime_error("AsyncSteadyStateMOCMA needs at least one starting point.");
+    }
+    if (function.numberOfObjectives() != 2) {
+        throw std::runtime_error("AsyncSteadyStateMOCMA only supports two objectives.");
+    }
+    if (m_parallelism == 0) {
+        throw std::runtime_error("AsyncSteadyStateMOCMA needs at least one offspring in flight.");
+    }
+    // finish the evaluations of a previous run before its slots are reused
+    m_evaluator.reset();
+    m_evaluator.reset(new AsyncEvaluator(function, m_workers ? m_workers : m_parallelism));
+    m_function = &function;
+
+    std::size_t n = function.numberOfVariables();
+    std::size_t slots = m_mu + m_parallelism;
+    m_constants = MOCMAConstants(n);
+    m_front.clear();
+    if (m_indicator.reference.size() == 2) {
+        m_front.setReference(m_indicator.reference(0), m_indicator.reference(1));
+    } else {
+        m_front.clearReference();
+    }
+
+    m_store.resize(slots, n, 2);
+    m_individuals.resize(slots);
+    m_slots.assign(m_mu + 1, 0);
+    m_best.resize(m_mu);
+    m_births = 0;
+    // the initial population is evaluated in parallel as well
+    for (std::size_t i = 0; i != m_mu; i++) {
+        m_store.setPoint(i, initialSearchPoints[i % initialSearchPoints.size()]);
+        m_evaluator->submit(i, evaluationPoint(function, i));
+    }
+    for (std::size_t k = 0; k != m_mu; k++) {
+        AsyncEvaluator::Result result = m_evaluator->next();
+        std::size_t i = result.ticket;
+        m_penalizedValue = result.value;
+        for (std::size_t j = 0; j != 2; j++) m_penalizedValue(j) += m_penaltyFactor * m_individuals[i].penalty;
+        m_store.setValues(i, result.value, m_penalizedValue);
+    }
+    for (std::size_t i = 0; i != m_mu; i++) {
+        Individual& individual = m_individuals[i];
+        individual.chromosome.init(n, m_initialSigma, m_constants);
+        individual.handle = m_front.insert(m_store.penalizedValue(i)[0], m_store.penalizedValue(i)[1]);
+        m_slots[individual.handle] = i;
+        individual.solution = i;
+        individual.birth = ++m_births;
+        m_store.getPoint(i, m_best[i].point);
+        m_store.getValue(i, m_best[i].value);
+    }
+    m_free.clear();
+    for (std::size_t s = slots; s != m_mu; s--) {
+        m_individuals[s - 1].birth = 0;
+        m_free.push_back(s - 1);
+    }
+
+    std::uint64_t seed = random::globalRng()();
+    seed = (seed << 32) | static_cast<std::uint32_t>(random::globalRng()());
+    m_rng.seed(seed);
+    m_z.resize(n);
+    for (std::size_t p = 0; p != m_parallelism; p++) submit(function);
+}
+
+void AsyncSteadyStateMOCMA::step(ObjectiveFunctionType const& function) {
+    if (&function != m_function) {
+        throw std::runtime_error("AsyncSteadyStateMOCMA::step() needs the function passed to init().");
+    }
+    AsyncEvaluator::Result result = m_evaluator->next();
+    integrate(result.ticket, result.value);
+    submit(function);
+}
+
+void AsyncSteadyStateMOCMA::submit(ObjectiveFunctionType const& function) {
+    std::size_t slot = m_free.back();
+    m_free.pop_back();
+    std::uniform_int_distribution<std::size_t> pick(0, m_front.frontSize(0) - 1);
+    std::size_t parentSlot = m_slots[m_front.nth(0, pick(m_rng))];
+    Individual& parent = m_individuals[parentSlot];
+    Individual& offspring = m_individuals[slot];
+    m_store.copy(parentSlot, slot);
+    offspring.chromosome.assign(parent.chromosome);
+    offspring.chromosome.mutate(m_store.point(slot), m_z, m_rng);
+    offspring.birth = ++m_births;
+    offspring.parent = parentSlot;
+    offspring.parentBirth = parent.birth;
+    m_evaluator->submit(slot, evaluationPoint(function, slot));
+}
+
+RealVector const& AsyncSteadyStateMOCMA::evaluationPoint(ObjectiveFunctionType const& function, std::size_t slot) {
+    m_store.getPoint(slot, m_point);
+    m_individuals[slot].penalty = 0.0;
+    if (function.isFeasible(m_point)) return m_point;
+    m_feasible = m_point;
+    function.closestFeasible(m_feasible);
+    for (std::size_t k = 0; k != m_point.size(); k++) {
+        double d = m_point(k) - m_feasible(k);
+        m_individuals[slot].penalty += d * d;
+    }
+    return m_feasible;
+}
+
+void AsyncSteadyStateMOCMA::integrate(std::size_t slot, RealVector const& value) {
+    Individual& offspring = m_individuals[slot];
+    if (m_penalizedValue.size() != value.size()) m_penalizedValue.resize(value.size());
+    for (std::size_t k = 0; k != value.size(); k++) m_penalizedValue(k) = value(k) + m_penaltyFactor * offspring.penalty;
+    m_store.setValues(slot, value, m_penalizedValue);
+
+    // the handles are recycled, so there is always a slot entry for them
+    offspring.handle = m_front.insert(m_store.penalizedValue(slot)[0], m_store.penalizedValue(slot)[1]);
+    m_slots[offspring.handle] = slot;
+    Individual& parent = m_individuals[offspring.parent];
+    bool parentAlive = parent.birth == offspring.parentBirth;
+    std::size_t offspringRank = m_front.rank(offspring.handle);
+    std::size_t parentRank = parentAlive ? m_front.rank(parent.handle) : offspringRank;
+
+    std::size_t removedHandle = m_front.leastContributor();
+    std::size_t removedSlot = m_slots[removedHandle];
+    m_front.erase(removedHandle);
+
+    bool survived = removedSlot != slot;
+    double success;
+    if (m_notionOfSuccess == NotionOfSuccess::PopulationBased) {
+        success = survived ? 1.0 : 0.0;
+    } else {
+        success = survived && offspringRank <= parentRank ? 1.0 : 0.0;
+    }
+    if (parentAlive && removedSlot != offspring.parent) {
+        parent.chromosome.updateStepSize(success, m_constants);
+    }
+    if (!survived) {
+        offspring.birth = 0;
+        m_free.push_back(slot);
+        return;
+    }
+
+    offspring.chromosome.updateStepSize(success, m_constants);
+    offspring.chromosome.updateCovariance(m_constants);
+
+    // the offspring takes over the solution entry of the removed individual
+    offspring.solution = m_individuals[removedSlot].solution;
+    m_store.getPoint(slot, m_best[offspring.solution].point);
+    m_store.getValue(slot, m_best[offspring.solution].value);
+    m_individuals[removedSlot].birth = 0;
+    m_free.push_back(removedSlot);
+}
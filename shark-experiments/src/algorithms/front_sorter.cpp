@@ -0,0 +1,269 @@
+/* front_sorter.cpp
+ *
+ * DESCRIPTION
+ * Duplicates are merged first and the distinct points are sorted
+ * lexicographically, so a point can only be dominated by points that come
+ * before it. helperA(S, k) ranks S among itself looking at objectives
+ * 0..k only (the points of S agree on the objectives above k);
+ * helperB(L, H, k) raises the ranks of H by the dominating points of L
+ * (every point of L is at most as large as every point of H on the
+ * objectives above k, and the ranks of L are final). Both split at the
+ * median of objective k and drop to k - 1 where one side is known to be
+ * no larger than the other. At k = 1 the remaining two objectives are
+ * handled by a sweep over a staircase of (objective 1, rank) pairs.
+ *
+ * REFERENCES
+ * - M. Buzdalov and A. Shalyto. A Provably Asymptotically Fast Version of
+ *   the Generalized Jensen Algorithm for Non-dominated Sorting. PPSN 2014.
+ */
+#include "algorithms/front_sorter.h"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <numeric>
+
+namespace {
+
+// below these sizes the quadratic scan is faster than splitting
+constexpr std::size_t BRUTE_A = 16;
+constexpr std::size_t BRUTE_B = 256;
+
+// (objective 1, front) pairs, increasing in both
+class Staircase {
+   public:
+    explicit Staircase(std::shared_ptr<NodeArena> const& arena) : m_steps(std::less<double>(), PoolAllocator<std::pair<double const, unsigned int>>(arena)) {}
+
+    // largest front among entries with key <= y, or -1
+    long query(double y) const {
+        auto it = m_steps.upper_bound(y);
+        if (it == m_steps.begin()) return -1;
+        return static_cast<long>(std::prev(it)->second);
+    }
+
+    void insert(double y, unsigned int rank) {
+        if (query(y) >= static_cast<long>(rank)) return;
+        auto it = m_steps.lower_bound(y);
+        while (it != m_steps.end() && it->second <= rank) it = m_steps.erase(it);
+        m_steps[y] = rank;
+    }
+
+   private:
+    std::map<double, unsigned int, std::less<double>, PoolAllocator<std::pair<double const, unsigned int>>> m_steps;
+};
+
+}  // namespace
+
+void FrontSorter::sort(double const* values, std::size_t size, std::size_t objectives, std::vector<unsigned int>& ranks) {
+    ranks.assign(size, 1);
+    if (size == 0 || objectives == 0) return;
+
+    auto less = [&](std::size_t a, std::size_t b) {
+        return std::lexicographical_compare(values + a * objectives, values + (a + 1) * objectives, values + b * objectives, values + (b + 1) * objectives);
+    };
+    m_order.resize(size);
+    std::iota(m_order.begin(), m_order.end(), 0);
+    std::sort(m_order.begin(), m_order.end(), less);
+
+    // m_distinct[i] is the distinct point of the i-th input point
+    m_objectives = objectives;
+    m_values.clear();
+    m_distinct.resize(size);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i != size; i++) {
+        std::size_t p = m_order[i];
+        if (i == 0 || less(m_order[i - 1], p)) {
+            m_values.insert(m_values.end(), values + p * objectives, values + (p + 1) * objectives);
+            count++;
+        }
+        m_distinct[p] = count - 1;
+    }
+    m_rank.assign(count, 0);
+
+    if (objectives == 1) {
+        std::iota(m_rank.begin(), m_rank.end(), 0);
+    } else if (objectives == 2) {
+        sweep2D();
+    } else {
+        auto all = indices();
+        all->resize(count);
+        std::iota(all->begin(), all->end(), 0);
+        helperA(*all, objectives - 1);
+    }
+
+    for (std::size_t p = 0; p != size; p++) ranks[p] = m_rank[m_distinct[p]] + 1;
+}
+
+// Points arrive ordered by objective 0. front[r] is the smallest objective 1
+// value in front r, which increases with r, and a point belongs to the
+// first front whose minimum exceeds its own objective 1.
+void FrontSorter::sweep2D() {
+    std::vector<double>& fronts = m_frontMinima;
+    fronts.clear();
+    std::size_t count = m_rank.size();
+    for (std::size_t p = 0; p != count; p++) {
+        double y = value(p, 1);
+        std::size_t r = std::upper_bound(fronts.begin(), fronts.end(), y) - fronts.begin();
+        if (r == fronts.size()) {
+            fronts.push_back(y);
+        } else {
+            fronts[r] = y;
+        }
+        m_rank[p] = static_cast<unsigned int>(r);
+    }
+}
+
+double FrontSorter::median(Indices const& points, std::size_t objective) {
+    m_medians.resize(points.size());
+    for (std::size_t i = 0; i != points.size(); i++) m_medians[i] = value(points[i], objective);
+    auto middle = m_medians.begin() + m_medians.size() / 2;
+    std::nth_element(m_medians.begin(), middle, m_medians.end());
+    return *middle;
+}
+
+void FrontSorter::helperA(Indices const& points, std::size_t objective) {
+    if (points.size() < 2) return;
+    if (points.size() <= BRUTE_A) {
+        bruteA(points, objective);
+        return;
+    }
+    if (objective == 1) {
+        sweepA(points);
+        return;
+    }
+
+    double m = median(points, objective);
+    auto lowerLease = indices(), equalLease = indices(), higherLease = indices();
+    Indices &lower = *lowerLease, &equal = *equalLease, &higher = *higherLease;
+    for (std::size_t p : points) {
+        double v = value(p, objective);
+        (v < m ? lower : v > m ? higher : equal).push_back(p);
+    }
+    if (lower.empty() && higher.empty()) {
+        helperA(points, objective - 1);
+        return;
+    }
+
+    helperA(lower, objective);
+    helperB(lower, equal, objective - 1);
+    helperA(equal, objective - 1);
+    auto notHigher = indices();
+    std::merge(lower.begin(), lower.end(), equal.begin(), equal.end(), std::back_inserter(*notHigher));
+    helperB(*notHigher, higher, objective - 1);
+    helperA(higher, objective);
+}
+
+void FrontSorter::helperB(Indices const& lower, Indices const& higher, std::size_t objective) {
+    if (lower.empty() || higher.empty()) return;
+    if (lower.size() == 1 || higher.size() == 1 || lower.size() * higher.size() <= BRUTE_B) {
+        bruteB(lower, higher, objective);
+        return;
+    }
+    if (objective == 1) {
+        sweepB(lower, higher);
+        return;
+    }
+
+    double lowerMin = value(lower[0], objective), lowerMax = lowerMin;
+    for (std::size_t p : lower) {
+        lowerMin = std::min(lowerMin, value(p, objective));
+        lowerMax = std::max(lowerMax, value(p, objective));
+    }
+    double higherMin = value(higher[0], objective), higherMax = higherMin;
+    for (std::size_t p : higher) {
+        higherMin = std::min(higherMin, value(p, objective));
+        higherMax = std::max(higherMax, value(p, objective));
+    }
+    if (lowerMax <= higherMin) {
+        helperB(lower, higher, objective - 1);
+        return;
+    }
+    if (lowerMin > higherMax) return;
+
+    auto both = indices();
+    both->insert(both->end(), lower.begin(), lower.end());
+    both->insert(both->end(), higher.begin(), higher.end());
+    double m = median(*both, objective);
+
+    // pairs with lower <= m <= higher are settled on objective k, the
+    // pairs on either side of m stay on k, the rest cannot dominate
+    auto lowerBelowLease = indices(), lowerUpToLease = indices(), lowerAboveLease = indices();
+    auto higherBelowLease = indices(), higherFromLease = indices(), higherAboveLease = indices();
+    Indices &lowerBelow = *lowerBelowLease, &lowerUpTo = *lowerUpToLease, &lowerAbove = *lowerAboveLease;
+    Indices &higherBelow = *higherBelowLease, &higherFrom = *higherFromLease, &higherAbove = *higherAboveLease;
+    for (std::size_t p : lower) {
+        double v = value(p, objective);
+        if (v < m) lowerBelow.push_back(p);
+        if (v <= m) lowerUpTo.push_back(p);
+        if (v > m) lowerAbove.push_back(p);
+    }
+    for (std::size_t p : higher) {
+        double v = value(p, objective);
+        if (v < m) higherBelow.push_back(p);
+        if (v >= m) higherFrom.push_back(p);
+        if (v > m) higherAbove.push_back(p);
+    }
+    helperB(lowerBelow, higherBelow, objective);
+    helperB(lowerUpTo, higherFrom, objective - 1);
+    helperB(lowerAbove, higherAbove, objective);
+}
+
+void FrontSorter::sweepA(Indices const& points) {
+    Staircase stairs(m_arena);
+    for (std::size_t p : points) {
+        double y = value(p, 1);
+        m_rank[p] = std::max<unsigned int>(m_rank[p], static_cast<unsigned int>(stairs.query(y) + 1));
+        stairs.insert(y, m_rank[p]);
+    }
+}
+
+// both sets are in lexicographic order, so a point of lower that comes
+// after h cannot be smaller than h on objectives 0 and 1
+void FrontSorter::sweepB(Indices const& lower, Indices const& higher) {
+    Staircase stairs(m_arena);
+    std::size_t next = 0;
+    for (std::size_t h : higher) {
+        while (next != lower.size() && lower[next] < h) {
+            stairs.insert(value(lower[next], 1), m_rank[lower[next]]);
+            next++;
+        }
+        m_rank[h] = std::max<unsigned int>(m_rank[h], static_cast<unsigned int>(stairs.query(value(h, 1)) + 1));
+    }
+}
+
+void FrontSorter::bruteA(Indices const& points, std::size_t objective) {
+    for (std::size_t i = 1; i != points.size(); i++) {
+        std::size_t h = points[i];
+        for (std::size_t j = 0; j != i; j++) {
+            std::size_t l = points[j];
+            bool below = true;
+            for (std::size_t k = 0; k <= objective; k++) below &= value(l, k) <= value(h, k);
+            if (below) m_rank[h] = std::max(m_rank[h], m_rank[l] + 1);
+        }
+    }
+}
+
+void FrontSorter::bruteB(Indices const& lower, Indices const& higher, std::size_t objective) {
+    std::size_t n = lower.size();
+    m_columns.resize((objective + 1) * n);
+    m_columnRanks.resize(n);
+    m_mask.resize(n);
+    for (std::size_t i = 0; i != n; i++) {
+        for (std::size_t k = 0; k <= objective; k++) m_columns[k * n + i] = value(lower[i], k);
+        m_columnRanks[i] = m_rank[lower[i]] + 1;
+    }
+    double const* columns = m_columns.data();
+    unsigned int const* ranks = m_columnRanks.data();
+    unsigned char* mask = m_mask.data();
+    for (std::size_t h : higher) {
+        std::fill(mask, mask + n, 1);
+        for (std::size_t k = 0; k <= objective; k++) {
+            double const* column = columns + k * n;
+            double bound = value(h, k);
+            for (std::size_t i = 0; i != n; i++) mask[i] &= column[i] <= bound;
+        }
+        unsigned int best = m_rank[h];
+        for (std::size_t i = 0; i != n; i++) best = std::max(best, mask[i] ? ranks[i] : 0u);
+        m_rank[h] = best;
+    }
+}
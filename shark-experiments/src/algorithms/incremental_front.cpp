@@ -0,0 +1,214 @@
+/* incremental_front.cpp
+ *
+ * DESCRIPTION
+ * Fronts are numbered from 0 (non-dominated). A point is dominated by a
+ * front iff its lexicographic predecessor in that front has an objective 1
+ * value no larger than its own (and is not a duplicate of it). Because
+ * every point of front r + 1 is dominated by some point of front r, the
+ * fronts dominating a point form a prefix, which makes the binary search
+ * in insert() valid. The points moving between two fronts are mutually
+ * non-dominated and kept in objective 0 order, so the points they dominate
+ * in the next front are found by one sweep over it.
+ */
+#include "algorithms/incremental_front.h"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t NO_HANDLE = std::numeric_limits<std::size_t>::max();
+
+}  // namespace
+
+IncrementalFront2D::IncrementalFront2D() : m_arena(std::make_shared<NodeArena>()), m_size(0), m_hasReference(false), m_reference0(0.0), m_reference1(0.0) {}
+
+void IncrementalFront2D::setReference(double reference0, double reference1) {
+    m_hasReference = true;
+    m_reference0 = reference0;
+    m_reference1 = reference1;
+    for (auto& front : m_fronts) {
+        for (auto it = front.points.begin(); it != front.points.end(); ++it) refresh(front, it);
+    }
+}
+
+void IncrementalFront2D::clearReference() {
+    m_hasReference = false;
+    for (auto& front : m_fronts) {
+        for (auto it = front.points.begin(); it != front.points.end(); ++it) refresh(front, it);
+    }
+}
+
+void IncrementalFront2D::clear() {
+    m_nodes.clear();
+    m_free.clear();
+    m_fronts.clear();
+    m_size = 0;
+}
+
+std::size_t IncrementalFront2D::insert(double value0, double value1) {
+    std::size_t handle;
+    if (m_free.empty()) {
+        handle = m_nodes.size();
+        m_nodes.emplace_back();
+    } else {
+        handle = m_free.back();
+        m_free.pop_back();
+    }
+    Key key{value0, value1, handle};
+    m_nodes[handle] = Node{key, 0, 0.0, true};
+    m_size++;
+
+    std::size_t lo = 0, hi = m_fronts.size();
+    while (lo < hi) {
+        std::size_t mid = (lo + hi) / 2;
+        if (dominatedBy(m_fronts[mid], key)) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == m_fronts.size()) m_fronts.emplace_back(m_arena);
+
+    m_next.assign(1, key);
+    m_current.clear();
+    dominatedIn(m_fronts[lo], m_next, m_current);
+    for (auto const& k : m_current) detach(k);
+    attach(lo, key);
+    pushDown(lo + 1);
+    return handle;
+}
+
+void IncrementalFront2D::erase(std::size_t handle) {
+    if (handle >= m_nodes.size() || !m_nodes[handle].used) {
+        throw std::runtime_error("IncrementalFront2D: invalid handle.");
+    }
+    Key key = m_nodes[handle].key;
+    std::size_t r = m_nodes[handle].front;
+    detach(key);
+    m_nodes[handle].used = false;
+    m_free.push_back(handle);
+    m_size--;
+
+    m_current.assign(1, key);
+    pullUp(r);
+    while (!m_fronts.empty() && m_fronts.back().points.empty()) m_fronts.pop_back();
+}
+
+std::vector<std::size_t> IncrementalFront2D::front(std::size_t r) const {
+    std::vector<std::size_t> ret;
+    ret.reserve(m_fronts[r].points.size());
+    for (auto const& key : m_fronts[r].points) ret.push_back(key.handle);
+    return ret;
+}
+
+std::size_t IncrementalFront2D::nth(std::size_t r, std::size_t i) const {
+    auto const& points = m_fronts[r].points;
+    if (i < points.size() / 2) return std::next(points.begin(), i)->handle;
+    return std::prev(points.end(), points.size() - i)->handle;
+}
+
+std::size_t IncrementalFront2D::leastContributor() const {
+    if (m_fronts.empty()) {
+        throw std::runtime_error("IncrementalFront2D: empty population.");
+    }
+    return m_fronts.back().contributions.begin()->second;
+}
+
+bool IncrementalFront2D::dominatedBy(Front const& front, Key const& key) const {
+    auto it = front.points.upper_bound(Key{key.value0, key.value1, NO_HANDLE});
+    if (it == front.points.begin()) return false;
+    --it;
+    if (it->value0 == key.value0 && it->value1 == key.value1) return false;
+    return it->value1 <= key.value1;
+}
+
+void IncrementalFront2D::dominatedIn(Front const& front, std::vector<Key> const& keys, std::vector<Key>& out) const {
+    // the range of every key starts and ends no earlier than that of the
+    // key before it, so the sweep continues where the last range ended
+    auto it = front.points.begin();
+    for (auto const& key : keys) {
+        if (it == front.points.end()) break;
+        auto first = front.points.upper_bound(Key{key.value0, key.value1, NO_HANDLE});
+        if (first == front.points.end()) break;
+        if (*it < *first) it = first;
+        for (; it != front.points.end() && it->value1 >= key.value1; ++it) {
+            out.push_back(*it);
+        }
+    }
+}
+
+void IncrementalFront2D::attach(std::size_t r, Key const& key) {
+    Front& front = m_fronts[r];
+    Node& node = m_nodes[key.handle];
+    node.front = r;
+    node.contribution = 0.0;
+    front.contributions.emplace(0.0, key.handle);
+    front.points.insert(key);
+    refreshAround(front, key);
+}
+
+void IncrementalFront2D::detach(Key const& key) {
+    Node& node = m_nodes[key.handle];
+    Front& front = m_fronts[node.front];
+    front.contributions.erase(std::make_pair(node.contribution, key.handle));
+    auto it = front.points.find(key);
+    auto next = front.points.erase(it);
+    if (next != front.points.end()) refresh(front, next);
+    if (next != front.points.begin()) refresh(front, std::prev(next));
+}
+
+void IncrementalFront2D::refresh(Front& front, KeyIterator it) {
+    Node& node = m_nodes[it->handle];
+    // without a reference point, that of the front is its worst point plus
+    // one, whose coordinates are those of its two extreme points
+    double up, right;
+    if (it != front.points.begin()) {
+        up = std::prev(it)->value1;
+    } else {
+        up = m_hasReference ? m_reference1 : it->value1 + 1.0;
+    }
+    auto next = std::next(it);
+    if (next != front.points.end()) {
+        right = next->value0;
+    } else {
+        right = m_hasReference ? m_reference0 : it->value0 + 1.0;
+    }
+    double contribution = std::max(0.0, right - it->value0) * std::max(0.0, up - it->value1);
+    front.contributions.erase(std::make_pair(node.contribution, it->handle));
+    node.contribution = contribution;
+    front.contributions.emplace(contribution, it->handle);
+}
+
+void IncrementalFront2D::refreshAround(Front& front, Key const& key) {
+    auto it = front.points.find(key);
+    refresh(front, it);
+    if (it != front.points.begin()) refresh(front, std::prev(it));
+    if (std::next(it) != front.points.end()) refresh(front, std::next(it));
+}
+
+void IncrementalFront2D::pushDown(std::size_t r) {
+    while (!m_current.empty()) {
+        if (r == m_fronts.size()) m_fronts.emplace_back(m_arena);
+        m_next.clear();
+        dominatedIn(m_fronts[r], m_current, m_next);
+        for (auto const& k : m_next) detach(k);
+        for (auto const& key : m_current) attach(r, key);
+        m_current.swap(m_next);
+        r++;
+    }
+}
+
+void IncrementalFront2D::pullUp(std::size_t r) {
+    while (!m_current.empty() && r + 1 < m_fronts.size()) {
+        m_next.clear();
+        dominatedIn(m_fronts[r + 1], m_current, m_next);
+        Front const& front = m_fronts[r];
+        m_next.erase(std::remove_if(m_next.begin(), m_next.end(), [&](Key const& k) { return dominatedBy(front, k); }), m_next.end());
+        for (auto const& k : m_next) detach(k);
+        for (auto const& k : m_next) attach(r, k);
+        m_current.swap(m_next);
+        r++;
+    }
+}
@@ -0,0 +1,212 @@
+/* island_model.cpp
+ *
+ * DESCRIPTION
+ * Threads, migration and the merged solution of IslandModel, instantiated
+ * for MOCMA, SMSEMOA and RealCodedNSGAII. Island 0 runs on the calling
+ * thread. Migration happens when an island crosses its next multiple of
+ * interval() * mu evaluations: it first sends its emigrants, then empties
+ * its mailbox and lets everything that arrived since the last migration
+ * replace its worst parents.
+ */
+#include "algorithms/island_model.h"
+
+#include <shark/Algorithms/DirectSearch/MOCMA.h>
+#include <shark/Algorithms/DirectSearch/RealCodedNSGAII.h>
+#include <shark/Algorithms/DirectSearch/SMS-EMOA.h>
+
+#include <algorithm>
+#include <exception>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace shark;
+
+template <typename Optimizer>
+void Island<Optimizer>::emigrants(std::size_t count, std::vector<IndividualType>& migrants) const {
+    std::vector<IndividualType const*> front;
+    for (auto const& individual : this->m_parents) {
+        if (individual.rank() == 1) front.push_back(&individual);
+    }
+    std::sort(front.begin(), front.end(), [](IndividualType const* a, IndividualType const* b) { return a->penalizedFitness()(0) < b->penalizedFitness()(0); });
+    migrants.clear();
+    if (front.size() <= count) {
+        for (auto individual : front) migrants.push_back(*individual);
+    } else if (count == 1) {
+        migrants.push_back(*front[front.size() / 2]);
+    } else {
+        for (std::size_t j = 0; j != count; j++) migrants.push_back(*front[j * (front.size() - 1) / (count - 1)]);
+    }
+}
+
+template <typename Optimizer>
+void Island<Optimizer>::immigrate(std::vector<IndividualType> const& migrants) {
+    std::vector<std::size_t> order(this->m_parents.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) { return this->m_parents[a].rank() > this->m_parents[b].rank(); });
+    std::size_t count = std::min(migrants.size(), order.size());
+    for (std::size_t j = 0; j != count; j++) this->m_parents[order[j]] = migrants[j];
+}
+
+// forwards to the shared function and counts the evaluations of one island,
+// which all happen on the island's thread
+template <typename Optimizer>
+class IslandModel<Optimizer>::Objective : public MultiObjectiveFunction {
+   public:
+    explicit Objective(MultiObjectiveFunction const& function) : m_function(function) {
+        if (function.hasConstraintHandler()) announceConstraintHandler(&function.getConstraintHandler());
+        if (function.canProposeStartingPoint()) m_features |= CAN_PROPOSE_STARTING_POINT;
+    }
+
+    std::string name() const override { return m_function.name(); }
+    std::size_t numberOfVariables() const override { return m_function.numberOfVariables(); }
+    std::size_t numberOfObjectives() const override { return m_function.numberOfObjectives(); }
+    SearchPointType proposeStartingPoint() const override { return m_function.proposeStartingPoint(); }
+    bool isFeasible(SearchPointType const& x) const override { return m_function.isFeasible(x); }
+    void closestFeasible(SearchPointType& x) const override { m_function.closestFeasible(x); }
+
+    ResultType eval(SearchPointType const& x) const override {
+        m_evaluationCounter++;
+        return m_function.eval(x);
+    }
+
+   private:
+    MultiObjectiveFunction const& m_function;
+};
+
+template <typename Optimizer>
+IslandModel<Optimizer>::IslandModel(std::size_t islands, std::function<void(Optimizer&)> const& configure) : m_topology(Topology::Ring), m_interval(10), m_migrants(4), m_archive(nullptr) {
+    if (islands == 0) {
+        throw std::runtime_error("IslandModel needs at least one island.");
+    }
+    for (std::size_t i = 0; i != islands; i++) {
+        m_islands.emplace_back(new Node);
+        m_islands[i]->optimizer.reset(new IslandType(m_islands[i]->rng));
+        configure(*m_islands[i]->optimizer);
+    }
+}
+
+template <typename Optimizer>
+IslandModel<Optimizer>::~IslandModel() {}
+
+template <typename Optimizer>
+void IslandModel<Optimizer>::run(MultiObjectiveFunction const& function, std::size_t budget) {
+    if (m_interval == 0) {
+        throw std::runtime_error("IslandModel needs a migration interval of at least one generation.");
+    }
+    m_sent.reset();
+    m_received.reset();
+    // seeding and initialisation stay on this thread, in island order
+    for (auto& island : m_islands) {
+        Message message;
+        while (island->mailbox.pop(message)) {
+        }
+        island->rng.seed(random::globalRng()());
+        island->function.reset(new Objective(function));
+        island->function->init();
+        island->optimizer->init(*island->function);
+    }
+
+    std::size_t count = m_islands.size();
+    std::vector<std::exception_ptr> errors(count);
+    auto work = [&](std::size_t i) {
+        try {
+            evolve(i, budget / count + (i < budget % count ? 1 : 0));
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i != count; i++) threads.emplace_back(work, i);
+    work(0);
+    for (auto& thread : threads) thread.join();
+    for (auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
+    updateSolution();
+}
+
+template <typename Optimizer>
+void IslandModel<Optimizer>::evolve(std::size_t i, std::size_t budget) {
+    Node& island = *m_islands[i];
+    std::size_t generation = island.optimizer->mu();
+    std::size_t next = m_interval * generation;
+    while (island.function->evaluationCounter() < budget) {
+        island.optimizer->step(*island.function);
+        if (island.function->evaluationCounter() >= next) {
+            if (m_archive) m_archive->insert(island.optimizer->solution());
+            migrate(i);
+            next += m_interval * generation;
+        }
+    }
+    if (m_archive) m_archive->insert(island.optimizer->solution());
+}
+
+template <typename Optimizer>
+void IslandModel<Optimizer>::migrate(std::size_t i) {
+    std::size_t count = m_islands.size();
+    if (count == 1) return;
+    Node& island = *m_islands[i];
+
+    island.optimizer->emigrants(m_migrants, island.migrants);
+    auto send = [&](std::size_t j) {
+        m_islands[j]->mailbox.push(Message{island.migrants});
+        m_sent.increment(island.migrants.size());
+    };
+    if (m_topology == Topology::Ring) {
+        send((i + 1) % count);
+    } else if (m_topology == Topology::FullyConnected) {
+        for (std::size_t j = 0; j != count; j++) {
+            if (j != i) send(j);
+        }
+    } else {
+        std::uniform_int_distribution<std::size_t> other(1, count - 1);
+        send((i + other(island.rng)) % count);
+    }
+
+    island.migrants.clear();
+    Message message;
+    while (island.mailbox.pop(message)) {
+        island.migrants.insert(island.migrants.end(), message.individuals.begin(), message.individuals.end());
+    }
+    if (island.migrants.empty()) return;
+    island.optimizer->immigrate(island.migrants);
+    m_received.increment(island.migrants.size());
+}
+
+template <typename Optimizer>
+void IslandModel<Optimizer>::updateSolution() {
+    SolutionType all;
+    for (auto const& island : m_islands) {
+        auto const& solution = island->optimizer->solution();
+        all.insert(all.end(), solution.begin(), solution.end());
+    }
+    auto dominates = [](RealVector const& a, RealVector const& b) {
+        bool better = false;
+        for (std::size_t k = 0; k != a.size(); k++) {
+            if (a(k) > b(k)) return false;
+            if (a(k) < b(k)) better = true;
+        }
+        return better;
+    };
+    m_solution.clear();
+    for (auto const& candidate : all) {
+        bool dominated = false;
+        for (auto const& other : all) {
+            if (dominates(other.value, candidate.value)) {
+                dominated = true;
+                break;
+            }
+        }
+        if (!dominated) m_solution.push_back(candidate);
+    }
+}
+
+template class Island<MOCMA>;
+template class Island<SMSEMOA>;
+template class Island<RealCodedNSGAII>;
+template class IslandModel<MOCMA>;
+template class IslandModel<SMSEMOA>;
+template class IslandModel<RealCodedNSGAII>;
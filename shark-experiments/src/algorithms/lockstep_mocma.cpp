@@ -0,0 +1,305 @@
+/* lockstep_mocma.cpp
+ *
+ * DESCRIPTION
+ * Generation loop of LockstepMOCMA. Loops over l < Lanes are innermost
+ * wherever the runs do the same work, so they compile to vector
+ * instructions; per-run branches (the evolution path update) are written
+ * as selects. Offspring that survive selection move into the slots of the
+ * parents that did not, which is the only data movement per lane.
+ *
+ * REFERENCES
+ * - C. Igel, N. Hansen and S. Roth. Covariance Matrix Adaptation for
+ *   Multi-objective Optimization. Evolutionary Computation 15(1), 2007.
+ */
+#include "algorithms/lockstep_mocma.h"
+
+#include <shark/Core/Random.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+
+using namespace shark;
+
+namespace {
+
+// first entry of row r of a packed lower triangular matrix
+inline std::size_t rowStart(std::size_t r) { return r * (r + 1) / 2; }
+
+}  // namespace
+
+template <std::size_t Lanes>
+LockstepMOCMA<Lanes>::LockstepMOCMA()
+    : m_mu(100), m_initialSigma(1.0), m_notionOfSuccess(NotionOfSuccess::PopulationBased), m_penaltyFactor(1e-6), m_n(0), m_triangle(0) {}
+
+template <std::size_t Lanes>
+void LockstepMOCMA<Lanes>::init(MOBenchmarkLanes<Lanes> const& function) {
+    if (m_mu == 0) {
+        throw std::runtime_error("LockstepMOCMA needs a positive population size.");
+    }
+    std::size_t n = function.numberOfVariables();
+    std::size_t slots = 2 * m_mu;
+    m_n = n;
+    m_triangle = n * (n + 1) / 2;
+    m_constants = MOCMAConstants(n);
+
+    m_points.assign(slots * n * Lanes, 0.0);
+    m_values.assign(slots * 2 * Lanes, 0.0);
+    m_penalizedValues.assign(slots * 2 * Lanes, 0.0);
+    m_stepSize.assign(slots * Lanes, m_initialSigma);
+    m_successProbability.assign(slots * Lanes, m_constants.targetSuccessProbability);
+    m_path.assign(slots * n * Lanes, 0.0);
+    m_factor.assign(slots * m_triangle * Lanes, 0.0);
+    m_lastStep.assign(slots * n * Lanes, 0.0);
+    m_rank.assign(slots * Lanes, 0);
+    m_selected.assign(slots * Lanes, 0);
+    for (std::size_t s = 0; s != slots; s++) {
+        for (std::size_t r = 0; r != n; r++) {
+            for (std::size_t l = 0; l != Lanes; l++) factor(s)[(rowStart(r) + r) * Lanes + l] = 1.0;
+        }
+    }
+    m_z.resize(n * Lanes);
+    m_normal.resize(n);
+    m_feasible.resize(n * Lanes);
+    m_fitness.resize(slots * 2);
+
+    std::uint64_t seed = random::globalRng()();
+    seed = (seed << 32) | static_cast<std::uint32_t>(random::globalRng()());
+    for (std::size_t l = 0; l != Lanes; l++) m_streams[l].seed(seed, l);
+    for (std::size_t i = 0; i != m_mu; i++) evaluate(function, i);
+}
+
+template <std::size_t Lanes>
+void LockstepMOCMA<Lanes>::step(MOBenchmarkLanes<Lanes> const& function) {
+    for (std::size_t i = 0; i != m_mu; i++) {
+        mutate(i);
+        evaluate(function, m_mu + i);
+    }
+    for (std::size_t l = 0; l != Lanes; l++) select(l);
+
+    // unselected individuals are updated too, they are overwritten anyway
+    double success[Lanes];
+    for (std::size_t i = 0; i != m_mu; i++) {
+        std::size_t o = m_mu + i;
+        for (std::size_t l = 0; l != Lanes; l++) {
+            bool selected = m_selected[o * Lanes + l] != 0;
+            if (m_notionOfSuccess == NotionOfSuccess::IndividualBased) selected &= m_rank[o * Lanes + l] <= m_rank[i * Lanes + l];
+            success[l] = selected ? 1.0 : 0.0;
+        }
+        updateStepSize(i, success);
+        updateStepSize(o, success);
+        updateCovariance(o);
+    }
+
+    // as many offspring survive as parents are dropped
+    for (std::size_t l = 0; l != Lanes; l++) {
+        m_holes.clear();
+        for (std::size_t i = 0; i != m_mu; i++) {
+            if (!m_selected[i * Lanes + l]) m_holes.push_back(i);
+        }
+        std::size_t next = 0;
+        for (std::size_t o = m_mu; o != 2 * m_mu; o++) {
+            if (m_selected[o * Lanes + l]) move(l, o, m_holes[next++]);
+        }
+    }
+}
+
+template <std::size_t Lanes>
+void LockstepMOCMA<Lanes>::solution(std::size_t lane, std::vector<RealVector>& points, std::vector<RealVector>& values) const {
+    points.resize(m_mu);
+    values.resize(m_mu);
+    for (std::size_t i = 0; i != m_mu; i++) {
+        points[i].resize(m_n);
+        values[i].resize(2);
+        for (std::size_t j = 0; j != m_n; j++) points[i](j) = m_points[(i * m_n + j) * Lanes + lane];
+        for (std::size_t k = 0; k != 2; k++) values[i](k) = m_values[(i * 2 + k) * Lanes + lane];
+    }
+}
+
+template <std::size_t Lanes>
+void LockstepMOCMA<Lanes>::mutate(std::size_t i) {
+    std::size_t n = m_n;
+    std::size_t o = m_mu + i;
+    std::copy_n(point(i), n * Lanes, point(o));
+    std::copy_n(path(i), n * Lanes, path(o));
+    std::copy_n(factor(i), m_triangle * Lanes, factor(o));
+    std::copy_n(m_stepSize.data() + i * Lanes, Lanes, m_stepSize.data() + o * Lanes);
+    std::copy_n(m_successProbability.data() + i * Lanes, Lanes, m_successProbability.data() + o * Lanes);
+
+    double* z = m_z.data();
+    for (std::size_t l = 0; l != Lanes; l++) {
+        m_streams[l].normal(m_normal.data(), n);
+        for (std::size_t j = 0; j != n; j++) z[j * Lanes + l] = m_normal[j];
+    }
+
+    double const* A = factor(o);
+    double const* sigma = m_stepSize.data() + o * Lanes;
+    double* x = point(o);
+    double* y = lastStep(o);
+    for (std::size_t r = 0; r != n; r++) {
+        double sum[Lanes] = {};
+        double const* row = A + rowStart(r) * Lanes;
+        for (std::size_t c = 0; c <= r; c++) {
+            for (std::size_t l = 0; l != Lanes; l++) sum[l] += row[c * Lanes + l] * z[c * Lanes + l];
+        }
+        for (std::size_t l = 0; l != Lanes; l++) {
+            y[r * Lanes + l] = sum[l];
+            x[r * Lanes + l] += sigma[l] * sum[l];
+        }
+    }
+}
+
+template <std::size_t Lanes>
+void LockstepMOCMA<Lanes>::evaluate(MOBenchmarkLanes<Lanes> const& function, std::size_t s) {
+    std::size_t n = m_n;
+    double const* x = point(s);
+    double const* lower = function.lower();
+    double const* upper = function.upper();
+    double* feasible = m_feasible.data();
+    double penalty[Lanes] = {};
+    for (std::size_t j = 0; j != n; j++) {
+        for (std::size_t l = 0; l != Lanes; l++) {
+            std::size_t e = j * Lanes + l;
+            feasible[e] = std::min(std::max(x[e], lower[e]), upper[e]);
+            double d = x[e] - feasible[e];
+            penalty[l] += d * d;
+        }
+    }
+    double* value = m_values.data() + s * 2 * Lanes;
+    double* penalized = m_penalizedValues.data() + s * 2 * Lanes;
+    function.eval(feasible, value);
+    for (std::size_t k = 0; k != 2; k++) {
+        for (std::size_t l = 0; l != Lanes; l++) penalized[k * Lanes + l] = value[k * Lanes + l] + m_penaltyFactor * penalty[l];
+    }
+}
+
+template <std::size_t Lanes>
+void LockstepMOCMA<Lanes>::select(std::size_t lane) {
+    std::size_t size = 2 * m_mu;
+    for (std::size_t s = 0; s != size; s++) {
+        for (std::size_t k = 0; k != 2; k++) m_fitness[s * 2 + k] = m_penalizedValues[(s * 2 + k) * Lanes + lane];
+    }
+    m_sorter.sort(m_fitness.data(), size, 2, m_ranks);
+    for (std::size_t s = 0; s != size; s++) {
+        m_rank[s * Lanes + lane] = m_ranks[s];
+        m_selected[s * Lanes + lane] = 0;
+    }
+
+    std::size_t chosen = 0;
+    for (unsigned int r = 1; chosen < m_mu; r++) {
+        m_front.clear();
+        for (std::size_t s = 0; s != size; s++) {
+            if (m_ranks[s] == r) m_front.push_back(s);
+        }
+        if (chosen + m_front.size() > m_mu) {
+            // objective 0 increases and objective 1 decreases along the front
+            auto f = [&](std::size_t s, std::size_t k) { return m_fitness[s * 2 + k]; };
+            std::sort(m_front.begin(), m_front.end(), [&](std::size_t a, std::size_t b) { return f(a, 0) < f(b, 0) || (f(a, 0) == f(b, 0) && f(a, 1) < f(b, 1)); });
+            double reference0 = f(m_front.back(), 0) + 1.0;
+            double reference1 = f(m_front.front(), 1) + 1.0;
+            while (chosen + m_front.size() > m_mu) {
+                std::size_t worst = 0;
+                double least = 0.0;
+                for (std::size_t j = 0; j != m_front.size(); j++) {
+                    double right = j + 1 < m_front.size() ? f(m_front[j + 1], 0) : reference0;
+                    double up = j > 0 ? f(m_front[j - 1], 1) : reference1;
+                    double contribution = (right - f(m_front[j], 0)) * (up - f(m_front[j], 1));
+                    if (j == 0 || contribution < least) {
+                        worst = j;
+                        least = contribution;
+                    }
+                }
+                m_front.erase(m_front.begin() + worst);
+            }
+        }
+        for (std::size_t s : m_front) m_selected[s * Lanes + lane] = 1;
+        chosen += m_front.size();
+    }
+}
+
+template <std::size_t Lanes>
+void LockstepMOCMA<Lanes>::updateStepSize(std::size_t s, double const* success) {
+    double cp = m_constants.successProbabilityRate;
+    double target = m_constants.targetSuccessProbability;
+    double scale = 1.0 / (m_constants.stepSizeDamping * (1.0 - target));
+    double* p = m_successProbability.data() + s * Lanes;
+    double* sigma = m_stepSize.data() + s * Lanes;
+    for (std::size_t l = 0; l != Lanes; l++) {
+        p[l] = (1.0 - cp) * p[l] + cp * success[l];
+        sigma[l] *= std::exp((p[l] - target) * scale);
+    }
+}
+
+template <std::size_t Lanes>
+void LockstepMOCMA<Lanes>::updateCovariance(std::size_t s) {
+    std::size_t n = m_n;
+    double cc = m_constants.evolutionPathRate;
+    double ccov = m_constants.covarianceRate;
+    double pathScale = std::sqrt(cc * (2.0 - cc));
+    double const* p = m_successProbability.data() + s * Lanes;
+    double* pc = path(s);
+    double* v = lastStep(s);
+
+    double below[Lanes], alpha[Lanes], beta[Lanes], root[Lanes];
+    for (std::size_t l = 0; l != Lanes; l++) {
+        below[l] = p[l] < m_constants.successThreshold ? 1.0 : 0.0;
+        alpha[l] = 1.0 - ccov + (1.0 - below[l]) * ccov * cc * (2.0 - cc);
+        beta[l] = std::sqrt(ccov / alpha[l]);
+        root[l] = std::sqrt(alpha[l]);
+    }
+    // the evolution path only follows the last step below the threshold,
+    // and v = beta p_c is the rank-one update
+    for (std::size_t j = 0; j != n; j++) {
+        for (std::size_t l = 0; l != Lanes; l++) {
+            std::size_t e = j * Lanes + l;
+            pc[e] = (1.0 - cc) * pc[e] + below[l] * pathScale * v[e];
+            v[e] = beta[l] * pc[e];
+        }
+    }
+
+    // A A^T + v v^T by Givens rotations, column by column
+    double* A = factor(s);
+    for (std::size_t k = 0; k != n; k++) {
+        double c[Lanes], sn[Lanes];
+        double* akk = A + (rowStart(k) + k) * Lanes;
+        for (std::size_t l = 0; l != Lanes; l++) {
+            double r = std::sqrt(akk[l] * akk[l] + v[k * Lanes + l] * v[k * Lanes + l]);
+            c[l] = r / akk[l];
+            sn[l] = v[k * Lanes + l] / akk[l];
+            akk[l] = r;
+        }
+        for (std::size_t i = k + 1; i != n; i++) {
+            double* aik = A + (rowStart(i) + k) * Lanes;
+            double* vi = v + i * Lanes;
+            for (std::size_t l = 0; l != Lanes; l++) {
+                aik[l] = (aik[l] + sn[l] * vi[l]) / c[l];
+                vi[l] = c[l] * vi[l] - sn[l] * aik[l];
+            }
+        }
+    }
+    for (std::size_t e = 0; e != m_triangle; e++) {
+        for (std::size_t l = 0; l != Lanes; l++) A[e * Lanes + l] *= root[l];
+    }
+}
+
+template <std::size_t Lanes>
+void LockstepMOCMA<Lanes>::move(std::size_t lane, std::size_t from, std::size_t to) {
+    auto copy = [lane](std::vector<double>& data, std::size_t size, std::size_t from, std::size_t to) {
+        for (std::size_t e = 0; e != size; e++) data[(to * size + e) * Lanes + lane] = data[(from * size + e) * Lanes + lane];
+    };
+    copy(m_points, m_n, from, to);
+    copy(m_values, 2, from, to);
+    copy(m_penalizedValues, 2, from, to);
+    copy(m_stepSize, 1, from, to);
+    copy(m_successProbability, 1, from, to);
+    copy(m_path, m_n, from, to);
+    copy(m_factor, m_triangle, from, to);
+    m_rank[to * Lanes + lane] = m_rank[from * Lanes + lane];
+    m_selected[to * Lanes + lane] = 1;
+}
+
+template class LockstepMOCMA<4>;
+template class LockstepMOCMA<8>;
+template class LockstepMOCMA<16>;
@@ -0,0 +1,137 @@
+/* mocma_chromosome.cpp
+ *
+ * DESCRIPTION
+ * Step size control by success rule and covariance update of [Igel 2007],
+ * with C = A A^T updated through A as in [Igel, Suttorp 2007].
+ */
+#include "algorithms/mocma_chromosome.h"
+
+#include <cmath>
+
+using namespace shark;
+
+namespace {
+
+// C = A A^T + v v^T for lower triangular A, v is overwritten
+void choleskyUpdate(RealMatrix& A, RealVector& v) {
+    std::size_t n = v.size();
+    for (std::size_t k = 0; k != n; k++) {
+        double akk = A(k, k);
+        double r = std::hypot(akk, v(k));
+        double c = r / akk;
+        double s = v(k) / akk;
+        A(k, k) = r;
+        for (std::size_t i = k + 1; i != n; i++) {
+            A(i, k) = (A(i, k) + s * v(i)) / c;
+            v(i) = c * v(i) - s * A(i, k);
+        }
+    }
+}
+
+}  // namespace
+
+MOCMAConstants::MOCMAConstants(std::size_t n) {
+    double dn = static_cast<double>(n);
+    stepSizeDamping = 1.0 + dn / 2.0;
+    targetSuccessProbability = 1.0 / (5.0 + 0.5);
+    successProbabilityRate = targetSuccessProbability / (2.0 + targetSuccessProbability);
+    evolutionPathRate = 2.0 / (dn + 2.0);
+    covarianceRate = 2.0 / (dn * dn + 6.0);
+    successThreshold = 0.44;
+}
+
+void MOCMAChromosome::init(std::size_t n, double sigma, MOCMAConstants const& constants) {
+    stepSize = sigma;
+    successProbability = constants.targetSuccessProbability;
+    if (evolutionPath.size() != n) {
+        evolutionPath.resize(n);
+        choleskyFactor.resize(n, n);
+        lastStep.resize(n);
+    }
+    for (std::size_t i = 0; i != n; i++) {
+        evolutionPath(i) = 0.0;
+        lastStep(i) = 0.0;
+        for (std::size_t j = 0; j != n; j++) choleskyFactor(i, j) = i == j ? 1.0 : 0.0;
+    }
+}
+
+void MOCMAChromosome::assign(MOCMAChromosome const& other) {
+    std::size_t n = other.evolutionPath.size();
+    stepSize = other.stepSize;
+    successProbability = other.successProbability;
+    if (evolutionPath.size() != n) {
+        *this = other;
+        return;
+    }
+    // the upper triangle of the Cholesky factor stays zero
+    for (std::size_t i = 0; i != n; i++) {
+        evolutionPath(i) = other.evolutionPath(i);
+        lastStep(i) = other.lastStep(i);
+        for (std::size_t j = 0; j <= i; j++) choleskyFactor(i, j) = other.choleskyFactor(i, j);
+    }
+}
+
+void MOCMAChromosome::mutate(double* point, RealVector& z, Philox& rng) {
+    std::size_t n = lastStep.size();
+    if (z.size() != n) z.resize(n);
+    rng.normal(&z(0), n);
+
+    RealMatrix const& A = choleskyFactor;
+    for (std::size_t r = 0; r != n; r++) {
+        double sum = 0.0;
+        for (std::size_t c = 0; c <= r; c++) sum += A(r, c) * z(c);
+        lastStep(r) = sum;
+        point[r] += stepSize * sum;
+    }
+}
+
+void MOCMAChromosome::updateStepSize(double success, MOCMAConstants const& constants) {
+    double cp = constants.successProbabilityRate;
+    double target = constants.targetSuccessProbability;
+    successProbability = (1.0 - cp) * successProbability + cp * success;
+    stepSize *= std::exp((successProbability - target) / (constants.stepSizeDamping * (1.0 - target)));
+}
+
+void MOCMAChromosome::updateCovariance(MOCMAConstants const& constants) {
+    std::size_t n = lastStep.size();
+    double cc = constants.evolutionPathRate;
+    double ccov = constants.covarianceRate;
+    double alpha;
+    if (successProbability < constants.successThreshold) {
+        double scale = std::sqrt(cc * (2.0 - cc));
+        for (std::size_t i = 0; i != n; i++) evolutionPath(i) = (1.0 - cc) * evolutionPath(i) + scale * lastStep(i);
+        alpha = 1.0 - ccov;
+    } else {
+        for (std::size_t i = 0; i != n; i++) evolutionPath(i) *= 1.0 - cc;
+        alpha = 1.0 - ccov + ccov * cc * (2.0 - cc);
+    }
+    // alpha A A^T + ccov p p^T = sqrt(alpha)^2 (A A^T + (ccov / alpha) p p^T)
+    double beta = std::sqrt(ccov / alpha);
+    RealVector& v = lastStep;
+    for (std::size_t i = 0; i != n; i++) v(i) = beta * evolutionPath(i);
+    choleskyUpdate(choleskyFactor, v);
+    double root = std::sqrt(alpha);
+    for (std::size_t i = 0; i != n; i++) {
+        for (std::size_t j = 0; j <= i; j++) choleskyFactor(i, j) *= root;
+    }
+}
+
+void evaluatePenalized(MultiObjectiveFunction const& function, RealVector const& point, RealVector& value, RealVector& penalizedValue, RealVector& feasible, double penaltyFactor) {
+    double penalty = 0.0;
+    if (function.isFeasible(point)) {
+        value = function.eval(point);
+    } else {
+        if (feasible.size() != point.size()) feasible.resize(point.size());
+        for (std::size_t k = 0; k != point.size(); k++) feasible(k) = point(k);
+        function.closestFeasible(feasible);
+        value = function.eval(feasible);
+        for (std::size_t k = 0; k != feasible.size(); k++) {
+            double d = point(k) - feasible(k);
+            penalty += d * d;
+        }
+    }
+    if (penalizedValue.size() != value.size()) penalizedValue.resize(value.size());
+    for (std::size_t k = 0; k != value.size(); k++) {
+        penalizedValue(k) = value(k) + penaltyFactor * penalty;
+    }
+}
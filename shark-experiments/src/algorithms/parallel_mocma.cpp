@@ -0,0 +1,217 @@
+/* parallel_mocma.cpp
+ *
+ * DESCRIPTION
+ * Generation loop of the (mu+mu)-MO-CMA-ES, see [Igel 2007] algorithm 4.
+ * Selection ranks the 2 mu individuals with FrontSorter and fills the last
+ * front by repeatedly dropping its least hypervolume contributor.
+ *
+ * REFERENCES
+ * - C. Igel, N. Hansen and S. Roth. Covariance Matrix Adaptation for
+ *   Multi-objective Optimization. Evolutionary Computation 15(1), 2007.
+ * - T. Voss, N. Hansen and C. Igel. Improved Step Size Adaptation for the
+ *   MO-CMA-ES. GECCO 2010.
+ */
+#include "algorithms/parallel_mocma.h"
+
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculator.h>
+#include <shark/Core/Random.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+
+using namespace shark;
+
+namespace {
+
+// hypervolume contribution of each of the first size points of a mutually
+// non-dominated set, order is scratch space
+void contributions(std::vector<RealVector> const& front, std::size_t size, RealVector const& reference, std::vector<double>& ret, std::vector<std::size_t>& order) {
+    ret.assign(size, 0.0);
+    if (reference.size() == 2) {
+        order.resize(size);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return front[a](0) < front[b](0); });
+        for (std::size_t j = 0; j != size; j++) {
+            RealVector const& p = front[order[j]];
+            double right = j + 1 < size ? front[order[j + 1]](0) : reference(0);
+            double up = j > 0 ? front[order[j - 1]](1) : reference(1);
+            ret[order[j]] = (right - p(0)) * (up - p(1));
+        }
+        return;
+    }
+    HypervolumeCalculator hv;
+    std::vector<RealVector> all(front.begin(), front.begin() + size);
+    double total = hv(all, reference);
+    std::vector<RealVector> others(all.begin() + 1, all.end());
+    for (std::size_t j = 0; j != size; j++) {
+        ret[j] = total - hv(others, reference);
+        if (j + 1 != size) others[j] = all[j];
+    }
+}
+
+}  // namespace
+
+ParallelMOCMA::ParallelMOCMA(std::size_t threads)
+    : m_mu(100), m_initialSigma(1.0), m_notionOfSuccess(NotionOfSuccess::PopulationBased), m_penaltyFactor(1e-6), m_pool(new ThreadPool(threads)) {}
+
+void ParallelMOCMA::setThreads(std::size_t threads) {
+    m_pool.reset(new ThreadPool(threads));
+    m_scratch.resize(m_pool->size());
+}
+
+void ParallelMOCMA::init(ObjectiveFunctionType const& function) {
+    std::vector<SearchPointType> points(m_mu);
+    for (auto& point : points) point = function.proposeStartingPoint();
+    init(function, points);
+}
+
+void ParallelMOCMA::init(ObjectiveFunctionType const& function, std::vector<SearchPointType> const& initialSearchPoints) {
+    if (initialSearchPoints.empty()) {
+        throw std::runtime_error("ParallelMOCMA needs at least one starting point.");
+    }
+    std::size_t n = function.numberOfVariables();
+    m_constants = MOCMAConstants(n);
+    m_store.resize(2 * m_mu, n, function.numberOfObjectives());
+    // keep the storage of a previous run with the same shape
+    m_population.resize(2 * m_mu);
+    m_scratch.resize(m_pool->size());
+    for (std::size_t i = 0; i != m_mu; i++) {
+        Individual& parent = m_population[i];
+        m_store.setPoint(i, initialSearchPoints[i % initialSearchPoints.size()]);
+        evaluate(function, i, 0);
+        parent.chromosome.init(n, m_initialSigma, m_constants);
+        parent.selected = true;
+    }
+    std::uint64_t seed = random::globalRng()();
+    seed = (seed << 32) | static_cast<std::uint32_t>(random::globalRng()());
+    m_streams.clear();
+    for (std::size_t i = 0; i != m_mu; i++) m_streams.emplace_back(seed, i);
+    updateSolution();
+}
+
+void ParallelMOCMA::step(ObjectiveFunctionType const& function) {
+    m_pool->parallelFor(m_mu, [this](std::size_t i, std::size_t worker) { mutate(i, worker); });
+
+    if (function.isThreadSafe()) {
+        m_pool->parallelFor(m_mu, [&](std::size_t i, std::size_t worker) { evaluate(function, m_mu + i, worker); });
+    } else {
+        for (std::size_t i = 0; i != m_mu; i++) evaluate(function, m_mu + i, 0);
+    }
+
+    select();
+
+    // every parent has exactly one offspring, so the pairs are independent
+    m_pool->parallelFor(m_mu, [this](std::size_t i, std::size_t) {
+        Individual& offspring = m_population[m_mu + i];
+        Individual& parent = m_population[offspring.parent];
+        double success;
+        if (m_notionOfSuccess == NotionOfSuccess::PopulationBased) {
+            success = offspring.selected ? 1.0 : 0.0;
+        } else {
+            success = offspring.selected && offspring.rank <= parent.rank ? 1.0 : 0.0;
+        }
+        if (parent.selected) {
+            parent.chromosome.updateStepSize(success, m_constants);
+        }
+        if (offspring.selected) {
+            offspring.chromosome.updateStepSize(success, m_constants);
+            offspring.chromosome.updateCovariance(m_constants);
+        }
+    });
+
+    // survivors become the parents in their current order, the rest is
+    // reused for the next offspring
+    std::size_t next = 0;
+    for (std::size_t a = 0; a != m_population.size(); a++) {
+        if (!m_population[a].selected) continue;
+        if (a != next) {
+            std::swap(m_population[a], m_population[next]);
+            m_store.swap(a, next);
+        }
+        next++;
+    }
+    updateSolution();
+}
+
+void ParallelMOCMA::mutate(std::size_t i, std::size_t worker) {
+    Individual const& parent = m_population[i];
+    Individual& offspring = m_population[m_mu + i];
+    m_store.copy(i, m_mu + i);
+    offspring.chromosome.assign(parent.chromosome);
+    offspring.parent = i;
+
+    offspring.chromosome.mutate(m_store.point(m_mu + i), m_scratch[worker].z, m_streams[i]);
+}
+
+void ParallelMOCMA::evaluate(ObjectiveFunctionType const& function, std::size_t i, std::size_t worker) {
+    Scratch& scratch = m_scratch[worker];
+    m_store.getPoint(i, scratch.point);
+    evaluatePenalized(function, scratch.point, scratch.value, scratch.penalizedValue, scratch.feasible, m_penaltyFactor);
+    m_store.setValues(i, scratch.value, scratch.penalizedValue);
+}
+
+void ParallelMOCMA::select() {
+    std::size_t size = m_population.size();
+    std::size_t objectives = m_store.numberOfObjectives();
+    m_sorter.sort(m_store.penalizedValues(), size, objectives, m_ranks);
+
+    // the inner vectors keep their capacity across generations
+    std::size_t numberOfFronts = 0;
+    for (std::size_t a = 0; a != size; a++) {
+        m_population[a].rank = m_ranks[a];
+        m_population[a].selected = false;
+        numberOfFronts = std::max<std::size_t>(numberOfFronts, m_ranks[a]);
+    }
+    if (m_fronts.size() < numberOfFronts) m_fronts.resize(numberOfFronts);
+    for (std::size_t r = 0; r != numberOfFronts; r++) m_fronts[r].clear();
+    for (std::size_t a = 0; a != size; a++) m_fronts[m_ranks[a] - 1].push_back(a);
+
+    std::size_t chosen = 0;
+    for (std::size_t r = 0; r != numberOfFronts; r++) {
+        std::vector<std::size_t>& front = m_fronts[r];
+        if (chosen + front.size() <= m_mu) {
+            for (std::size_t a : front) m_population[a].selected = true;
+            chosen += front.size();
+            continue;
+        }
+
+        // drop least contributors of the last front one at a time, the
+        // dropped vectors are rotated behind count to be reused
+        std::size_t count = front.size();
+        if (m_frontValues.size() < count) m_frontValues.resize(count);
+        for (std::size_t j = 0; j != count; j++) {
+            RealVector& value = m_frontValues[j];
+            if (value.size() != objectives) value.resize(objectives);
+            std::copy_n(m_store.penalizedValue(front[j]), objectives, value.begin());
+        }
+        if (m_reference.size() != objectives) m_reference.resize(objectives);
+        for (std::size_t k = 0; k != objectives; k++) {
+            if (m_indicator.reference.size() != 0) {
+                m_reference(k) = m_indicator.reference(k);
+                continue;
+            }
+            m_reference(k) = m_frontValues[0](k);
+            for (std::size_t j = 1; j != count; j++) m_reference(k) = std::max(m_reference(k), m_frontValues[j](k));
+            m_reference(k) += 1.0;
+        }
+        while (chosen + count > m_mu) {
+            contributions(m_frontValues, count, m_reference, m_contributions, m_order);
+            std::size_t worst = std::min_element(m_contributions.begin(), m_contributions.end()) - m_contributions.begin();
+            std::rotate(front.begin() + worst, front.begin() + worst + 1, front.begin() + count);
+            std::rotate(m_frontValues.begin() + worst, m_frontValues.begin() + worst + 1, m_frontValues.begin() + count);
+            count--;
+        }
+        for (std::size_t j = 0; j != count; j++) m_population[front[j]].selected = true;
+        break;
+    }
+}
+
+void ParallelMOCMA::updateSolution() {
+    m_best.resize(m_mu);
+    for (std::size_t i = 0; i != m_mu; i++) {
+        m_store.getPoint(i, m_best[i].point);
+        m_store.getValue(i, m_best[i].value);
+    }
+}
@@ -0,0 +1,150 @@
+/* philox.cpp
+ *
+ * DESCRIPTION
+ * Philox4x32-10 rounds on batches of counters, and Box-Muller on top.
+ */
+#include "algorithms/philox.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+constexpr std::uint32_t M0 = 0xD2511F53u;
+constexpr std::uint32_t M1 = 0xCD9E8D57u;
+constexpr std::uint32_t W0 = 0x9E3779B9u;
+constexpr std::uint32_t W1 = 0xBB67AE85u;
+
+// blocks encrypted per batch of normal()
+constexpr std::size_t BATCH = 64;
+// blocks per iteration of the widest vector loop (AVX-512 on doubles)
+constexpr std::size_t LANES = 8;
+
+// ten rounds on m independent counters (c0, c1, c2, c3)[i]
+void rounds(std::uint64_t key, std::size_t m, std::uint32_t* c0, std::uint32_t* c1, std::uint32_t* c2, std::uint32_t* c3) {
+    std::uint32_t k0 = static_cast<std::uint32_t>(key);
+    std::uint32_t k1 = static_cast<std::uint32_t>(key >> 32);
+    for (int r = 0; r != 10; r++) {
+        for (std::size_t i = 0; i != m; i++) {
+            std::uint64_t p0 = static_cast<std::uint64_t>(M0) * c0[i];
+            std::uint64_t p1 = static_cast<std::uint64_t>(M1) * c2[i];
+            std::uint32_t x0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1[i] ^ k0;
+            std::uint32_t x1 = static_cast<std::uint32_t>(p1);
+            std::uint32_t x2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3[i] ^ k1;
+            std::uint32_t x3 = static_cast<std::uint32_t>(p0);
+            c0[i] = x0;
+            c1[i] = x1;
+            c2[i] = x2;
+            c3[i] = x3;
+        }
+        k0 += W0;
+        k1 += W1;
+    }
+}
+
+// double in [1, 2) with the 52 low bits of bits as mantissa; avoids
+// integer to floating point conversions, which lack vector instructions
+// before AVX-512
+inline double fromMantissa(std::uint64_t bits) {
+    bits = (bits & 0x000fffffffffffffull) | 0x3ff0000000000000ull;
+    double ret;
+    std::memcpy(&ret, &bits, sizeof ret);
+    return ret;
+}
+
+// log(u) for u in [2^-52, 1] as e ln 2 + log(m) with m in [sqrt(1/2), sqrt(2)),
+// log(m) = 2 atanh((m - 1) / (m + 1)) by its series; branch free so that
+// the batch loop vectorises, accurate to a few ulp
+inline double logUnit(double u) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &u, sizeof bits);
+    double e = static_cast<double>(static_cast<std::int32_t>(bits >> 52) - 1023);
+    double m = fromMantissa(bits);
+    bool high = m > 1.4142135623730951;
+    m = high ? 0.5 * m : m;
+    e = high ? e + 1.0 : e;
+    double s = (m - 1.0) / (m + 1.0);
+    double s2 = s * s;
+    double series = 1.0 / 23;
+    for (int k = 21; k >= 1; k -= 2) series = series * s2 + 1.0 / k;
+    return e * 6.93147180369123816490e-01 + (e * 1.90821492927058770002e-10 + 2.0 * s * series);
+}
+
+// sin and cos of 2 pi b / 2^54 for an integer b < 2^54: the top two bits
+// select the quadrant, the rest gives x in [0, pi / 2) for the Taylor
+// polynomials of degree 23 and 22 (truncation error below 1e-19)
+constexpr double SIN_COEFFICIENTS[] = {-1.0 / 25852016738884976640000.0, 1.0 / 51090942171709440000.0, -1.0 / 121645100408832000.0, 1.0 / 355687428096000.0, -1.0 / 1307674368000.0, 1.0 / 6227020800.0, -1.0 / 39916800.0, 1.0 / 362880.0, -1.0 / 5040.0, 1.0 / 120.0, -1.0 / 6.0, 1.0};
+constexpr double COS_COEFFICIENTS[] = {-1.0 / 1124000727777607680000.0, 1.0 / 2432902008176640000.0, -1.0 / 6402373705728000.0, 1.0 / 20922789888000.0, -1.0 / 87178291200.0, 1.0 / 479001600.0, -1.0 / 3628800.0, 1.0 / 40320.0, -1.0 / 720.0, 1.0 / 24.0, -1.0 / 2.0, 1.0};
+
+inline void sinCosTurn(std::uint64_t b, double& sine, double& cosine) {
+    std::uint64_t quadrant = b >> 52;
+    double x = (fromMantissa(b) - 1.0) * 1.5707963267948966;
+    double x2 = x * x;
+    double s = 0.0, c = 0.0;
+    for (int k = 0; k != 12; k++) {
+        s = s * x2 + SIN_COEFFICIENTS[k];
+        c = c * x2 + COS_COEFFICIENTS[k];
+    }
+    s *= x;
+    bool swap = quadrant & 1;
+    double sineSign = (quadrant & 2) ? -1.0 : 1.0;
+    double cosineSign = ((quadrant + 1) & 2) ? -1.0 : 1.0;
+    sine = sineSign * (swap ? c : s);
+    cosine = cosineSign * (swap ? s : c);
+}
+
+}  // namespace
+
+void Philox::seed(std::uint64_t seed, std::uint64_t stream) {
+    m_key = seed;
+    m_stream = stream;
+    m_counter = 0;
+    m_used = 4;
+}
+
+void Philox::block(std::uint64_t key, std::uint64_t counter, std::uint64_t stream, std::uint32_t* out) {
+    std::uint32_t c0 = static_cast<std::uint32_t>(counter);
+    std::uint32_t c1 = static_cast<std::uint32_t>(counter >> 32);
+    std::uint32_t c2 = static_cast<std::uint32_t>(stream);
+    std::uint32_t c3 = static_cast<std::uint32_t>(stream >> 32);
+    rounds(key, 1, &c0, &c1, &c2, &c3);
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+void Philox::normal(double* out, std::size_t n) {
+    std::uint32_t c0[BATCH], c1[BATCH], c2[BATCH], c3[BATCH];
+    double radius[BATCH], sine[BATCH], cosine[BATCH];
+    for (std::size_t done = 0; done < n; done += 2 * BATCH) {
+        std::size_t m = std::min(BATCH, (n - done + 1) / 2);
+        // the loops run over whole vectors; the blocks past m are wasted
+        // but cheaper than the scalar remainder loops for short buffers
+        std::size_t padded = (m + LANES - 1) / LANES * LANES;
+        for (std::size_t i = 0; i != padded; i++) {
+            std::uint64_t counter = m_counter + i;
+            c0[i] = static_cast<std::uint32_t>(counter);
+            c1[i] = static_cast<std::uint32_t>(counter >> 32);
+            c2[i] = static_cast<std::uint32_t>(m_stream);
+            c3[i] = static_cast<std::uint32_t>(m_stream >> 32);
+        }
+        m_counter += m;
+        rounds(m_key, padded, c0, c1, c2, c3);
+        // radius from u in (0, 1] with 52 random bits, angle from 54 bits
+        for (std::size_t i = 0; i != padded; i++) {
+            std::uint64_t a = (static_cast<std::uint64_t>(c0[i]) << 32) | c1[i];
+            std::uint64_t b = ((static_cast<std::uint64_t>(c2[i]) << 32) | c3[i]) >> 10;
+            radius[i] = std::sqrt(-2.0 * logUnit(2.0 - fromMantissa(a)));
+            sinCosTurn(b, sine[i], cosine[i]);
+        }
+        double* target = out + done;
+        std::size_t count = std::min(2 * m, n - done);
+        for (std::size_t i = 0; i != count / 2; i++) {
+            target[2 * i] = radius[i] * cosine[i];
+            target[2 * i + 1] = radius[i] * sine[i];
+        }
+        if (count % 2) target[count - 1] = radius[count / 2] * cosine[count / 2];
+    }
+}
@@ -0,0 +1,52 @@
+/* population_store.cpp
+ *
+ * DESCRIPTION
+ * Row operations of PopulationStore.
+ */
+#include "algorithms/population_store.h"
+
+#include <algorithm>
+
+using namespace shark;
+
+PopulationStore::PopulationStore() : m_size(0), m_numberOfVariables(0), m_numberOfObjectives(0) {}
+
+void PopulationStore::resize(std::size_t size, std::size_t numberOfVariables, std::size_t numberOfObjectives) {
+    m_size = size;
+    m_numberOfVariables = numberOfVariables;
+    m_numberOfObjectives = numberOfObjectives;
+    m_points.resize(size * numberOfVariables);
+    m_values.resize(size * numberOfObjectives);
+    m_penalizedValues.resize(size * numberOfObjectives);
+}
+
+void PopulationStore::copy(std::size_t from, std::size_t to) {
+    std::copy_n(point(from), m_numberOfVariables, point(to));
+    std::copy_n(value(from), m_numberOfObjectives, value(to));
+    std::copy_n(penalizedValue(from), m_numberOfObjectives, penalizedValue(to));
+}
+
+void PopulationStore::swap(std::size_t a, std::size_t b) {
+    std::swap_ranges(point(a), point(a) + m_numberOfVariables, point(b));
+    std::swap_ranges(value(a), value(a) + m_numberOfObjectives, value(b));
+    std::swap_ranges(penalizedValue(a), penalizedValue(a) + m_numberOfObjectives, penalizedValue(b));
+}
+
+void PopulationStore::getPoint(std::size_t i, RealVector& point) const {
+    if (point.size() != m_numberOfVariables) point.resize(m_numberOfVariables);
+    std::copy_n(this->point(i), m_numberOfVariables, point.begin());
+}
+
+void PopulationStore::setPoint(std::size_t i, RealVector const& point) {
+    std::copy_n(point.begin(), m_numberOfVariables, this->point(i));
+}
+
+void PopulationStore::getValue(std::size_t i, RealVector& value) const {
+    if (value.size() != m_numberOfObjectives) value.resize(m_numberOfObjectives);
+    std::copy_n(this->value(i), m_numberOfObjectives, value.begin());
+}
+
+void PopulationStore::setValues(std::size_t i, RealVector const& value, RealVector const& penalizedValue) {
+    std::copy_n(value.begin(), m_numberOfObjectives, this->value(i));
+    std::copy_n(penalizedValue.begin(), m_numberOfObjectives, this->penalizedValue(i));
+}
@@ -0,0 +1,117 @@
+/* steady_state_mocma.cpp
+ *
+ * DESCRIPTION
+ * Step of the (mu+1)-MO-CMA-ES, see [Igel 2007b] algorithm 1: the parent is
+ * drawn uniformly from the non-dominated individuals, the offspring joins
+ * the population and the least contributor of the worst front leaves it.
+ *
+ * REFERENCES
+ * - [Igel 2007b] C. Igel, T. Suttorp and N. Hansen. Steady-state Selection
+ *   and Efficient Covariance Matrix Update in the Multi-objective CMA-ES.
+ *   EMO 2007.
+ */
+#include "algorithms/steady_state_mocma.h"
+
+#include <shark/Core/Random.h>
+
+#include <cstdint>
+#include <stdexcept>
+
+using namespace shark;
+
+IncrementalSteadyStateMOCMA::IncrementalSteadyStateMOCMA()
+    : m_mu(100), m_initialSigma(1.0), m_notionOfSuccess(NotionOfSuccess::PopulationBased), m_penaltyFactor(1e-6), m_spare(0) {}
+
+void IncrementalSteadyStateMOCMA::init(ObjectiveFunctionType const& function) {
+    std::vector<SearchPointType> points(m_mu);
+    for (auto& point : points) point = function.proposeStartingPoint();
+    init(function, points);
+}
+
+void IncrementalSteadyStateMOCMA::init(ObjectiveFunctionType const& function, std::vector<SearchPointType> const& initialSearchPoints) {
+    if (initialSearchPoints.empty()) {
+        throw std::runtime_error("IncrementalSteadyStateMOCMA needs at least one starting point.");
+    }
+    if (function.numberOfObjectives() != 2) {
+        throw std::runtime_error("IncrementalSteadyStateMOCMA only supports two objectives.");
+    }
+    std::size_t n = function.numberOfVariables();
+    m_constants = MOCMAConstants(n);
+    m_front.clear();
+    if (m_indicator.reference.size() == 2) {
+        m_front.setReference(m_indicator.reference(0), m_indicator.reference(1));
+    } else {
+        m_front.clearReference();
+    }
+
+    m_store.resize(m_mu + 1, n, 2);
+    // keep the storage of a previous run with the same shape
+    m_individuals.resize(m_mu + 1);
+    m_slots.assign(m_mu + 1, 0);
+    m_best.resize(m_mu);
+    for (std::size_t i = 0; i != m_mu; i++) {
+        Individual& individual = m_individuals[i];
+        m_store.setPoint(i, initialSearchPoints[i % initialSearchPoints.size()]);
+        evaluate(function, i);
+        individual.chromosome.init(n, m_initialSigma, m_constants);
+        individual.handle = m_front.insert(m_store.penalizedValue(i)[0], m_store.penalizedValue(i)[1]);
+        m_slots[individual.handle] = i;
+        individual.solution = i;
+        m_store.getPoint(i, m_best[i].point);
+        m_store.getValue(i, m_best[i].value);
+    }
+    m_spare = m_mu;
+
+    std::uint64_t seed = random::globalRng()();
+    seed = (seed << 32) | static_cast<std::uint32_t>(random::globalRng()());
+    m_rng.seed(seed);
+    m_z.resize(n);
+}
+
+void IncrementalSteadyStateMOCMA::step(ObjectiveFunctionType const& function) {
+    std::uniform_int_distribution<std::size_t> pick(0, m_front.frontSize(0) - 1);
+    std::size_t parentSlot = m_slots[m_front.nth(0, pick(m_rng))];
+    Individual& parent = m_individuals[parentSlot];
+    Individual& offspring = m_individuals[m_spare];
+    m_store.copy(parentSlot, m_spare);
+    offspring.chromosome.assign(parent.chromosome);
+    offspring.chromosome.mutate(m_store.point(m_spare), m_z, m_rng);
+    evaluate(function, m_spare);
+
+    // the handles are recycled, so there is always a slot entry for them
+    offspring.handle = m_front.insert(m_store.penalizedValue(m_spare)[0], m_store.penalizedValue(m_spare)[1]);
+    m_slots[offspring.handle] = m_spare;
+    std::size_t offspringRank = m_front.rank(offspring.handle);
+    std::size_t parentRank = m_front.rank(parent.handle);
+
+    std::size_t removedHandle = m_front.leastContributor();
+    std::size_t removedSlot = m_slots[removedHandle];
+    m_front.erase(removedHandle);
+
+    bool survived = removedSlot != m_spare;
+    double success;
+    if (m_notionOfSuccess == NotionOfSuccess::PopulationBased) {
+        success = survived ? 1.0 : 0.0;
+    } else {
+        success = survived && offspringRank <= parentRank ? 1.0 : 0.0;
+    }
+    if (removedSlot != parentSlot) {
+        parent.chromosome.updateStepSize(success, m_constants);
+    }
+    if (!survived) return;
+
+    offspring.chromosome.updateStepSize(success, m_constants);
+    offspring.chromosome.updateCovariance(m_constants);
+
+    // the offspring takes over the solution entry of the removed individual
+    offspring.solution = m_individuals[removedSlot].solution;
+    m_store.getPoint(m_spare, m_best[offspring.solution].point);
+    m_store.getValue(m_spare, m_best[offspring.solution].value);
+    m_spare = removedSlot;
+}
+
+void IncrementalSteadyStateMOCMA::evaluate(ObjectiveFunctionType const& function, std::size_t slot) {
+    m_store.getPoint(slot, m_point);
+    evaluatePenalized(function, m_point, m_value, m_penalizedValue, m_feasible, m_penaltyFactor);
+    m_store.setValues(slot, m_value, m_penalizedValue);
+}
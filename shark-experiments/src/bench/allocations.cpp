@@ -0,0 +1,77 @@
+/* allocations.cpp
+ *
+ * DESCRIPTION
+ * Counts heap allocations per evaluation of ParallelMOCMA and
+ * IncrementalSteadyStateMOCMA once the optimizers are warmed up, and for a
+ * second init() of the same optimizer object as done when the experiment
+ * drivers move on to the next instance. The objective function interface
+ * returns its values by value, which accounts for (at least) one
+ * allocation per evaluation; everything above that is the optimizer.
+ *
+ * Usage: bench_allocations [n] [mu] [evaluations]
+ */
+#include <shark/Core/Random.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Benchmarks.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+#include "algorithms/parallel_mocma.h"
+#include "algorithms/steady_state_mocma.h"
+
+using namespace shark;
+
+static std::atomic<std::uint64_t> allocations(0);
+
+void *operator new(std::size_t size) {
+    allocations++;
+    if (void *p = std::malloc(size == 0 ? 1 : size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+template <typename Optimizer>
+void count(char const *name, Optimizer &optimizer, int n, int evaluations) {
+    benchmarks::ZDT1 fn(n);
+    fn.init();
+    optimizer.init(fn);
+    // warm up until the scratch buffers reached their final size
+    while (fn.evaluationCounter() < static_cast<std::size_t>(evaluations)) optimizer.step(fn);
+
+    std::size_t start = fn.evaluationCounter();
+    std::uint64_t before = allocations;
+    while (fn.evaluationCounter() < start + evaluations) optimizer.step(fn);
+    double perEvaluation = static_cast<double>(allocations - before) / (fn.evaluationCounter() - start);
+
+    before = allocations;
+    optimizer.init(fn);
+    std::uint64_t init = allocations - before;
+
+    std::cout << name << perEvaluation << " allocations/eval, " << init << " allocations in init()" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 10;
+    int mu = argc > 2 ? std::atoi(argv[2]) : 20;
+    int evaluations = argc > 3 ? std::atoi(argv[3]) : 20000;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "n=" << n << " mu=" << mu << std::endl;
+
+    random::globalRng().seed(1);
+    ParallelMOCMA parallel(1);
+    parallel.mu() = mu;
+    count("ParallelMOCMA                ", parallel, n, evaluations);
+
+    random::globalRng().seed(1);
+    IncrementalSteadyStateMOCMA steadyState;
+    steadyState.mu() = mu;
+    steadyState.indicator().setReference(RealVector(2, 11.0));
+    count("IncrementalSteadyStateMOCMA  ", steadyState, n, evaluations);
+}
@@ -0,0 +1,90 @@
+/* async_evaluation.cpp
+ *
+ * DESCRIPTION
+ * Throughput and idle time of an AsyncEvaluator on a MOBenchmark instance
+ * behind a LatencyObjective, for increasing worker counts. With W workers
+ * the batch driver submits W points and collects all of them before the
+ * next batch, as a generational optimizer does; the asynchronous driver
+ * keeps W evaluations in flight and submits a new point as soon as one
+ * finishes. Utilisation is the time the workers spent evaluating over W
+ * times the wall time.
+ *
+ * Usage: bench_async_evaluation [max workers] [evaluations] [median ms]
+ *                               [constant|lognormal|pareto] [shape] [sleep|spin]
+ */
+#include <stdlib.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "algorithms/philox.h"
+#include "moq/benchmarks.h"
+#include "moq/latency_objective.h"
+#include "parallel/async_evaluator.h"
+
+using namespace shark;
+
+RealVector randomPoint(Philox &rng, std::size_t n) {
+    std::uniform_real_distribution<double> uniform(-5.0, 5.0);
+    RealVector ret(n);
+    for (std::size_t i = 0; i != n; i++) ret(i) = uniform(rng);
+    return ret;
+}
+
+void run(LatencyObjective &f, std::size_t workers, std::size_t evaluations, bool batch) {
+    Philox rng(1);
+    f.init();
+    AsyncEvaluator evaluator(f, workers);
+    std::size_t submitted = 0, finished = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (finished < evaluations) {
+        if (batch) {
+            for (std::size_t w = 0; w != workers && submitted < evaluations; w++, submitted++) evaluator.submit(submitted, randomPoint(rng, f.numberOfVariables()));
+            while (evaluator.inFlight()) {
+                evaluator.next();
+                finished++;
+            }
+        } else {
+            while (evaluator.inFlight() < workers && submitted < evaluations) evaluator.submit(submitted++, randomPoint(rng, f.numberOfVariables()));
+            evaluator.next();
+            finished++;
+        }
+    }
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+    std::cout << std::setw(3) << workers << (batch ? " workers  batch  " : " workers  async  ") << std::setw(9) << evaluations / wall.count() << " evals/s  utilisation "
+              << std::setw(5) << 100.0 * evaluator.busySeconds() / (workers * wall.count()) << "%  driver waited " << evaluator.waitSeconds() << " s" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t maxWorkers = argc > 1 ? std::atoi(argv[1]) : 16;
+    std::size_t evaluations = argc > 2 ? std::atoi(argv[2]) : 2000;
+    std::string distribution = argc > 4 ? argv[4] : "lognormal";
+    std::string wait = argc > 6 ? argv[6] : "sleep";
+
+    LatencyObjective::Latency latency;
+    latency.median = (argc > 3 ? std::atof(argv[3]) : 2.0) * 1e-3;
+    latency.shape = argc > 5 ? std::atof(argv[5]) : 1.0;
+    if (distribution == "constant") {
+        latency.distribution = LatencyObjective::Distribution::Constant;
+    } else if (distribution == "lognormal") {
+        latency.distribution = LatencyObjective::Distribution::LogNormal;
+    } else if (distribution == "pareto") {
+        latency.distribution = LatencyObjective::Distribution::Pareto;
+    } else {
+        throw std::runtime_error("unknown distribution: " + distribution);
+    }
+    latency.wait = wait == "spin" ? LatencyObjective::Wait::Spin : LatencyObjective::Wait::Sleep;
+
+    MOBenchmark benchmark("1/C", 10, 0);
+    LatencyObjective f(benchmark, latency);
+    std::cout << distribution << " median " << latency.median * 1e3 << " ms shape " << latency.shape << " (" << wait << "), " << evaluations << " evaluations" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    for (std::size_t workers = 1; workers <= maxWorkers; workers *= 2) {
+        run(f, workers, evaluations, true);
+        run(f, workers, evaluations, false);
+    }
+}
@@ -0,0 +1,86 @@
+/* async_steady_state.cpp
+ *
+ * DESCRIPTION
+ * Wall clock against evaluations for AsyncSteadyStateMOCMA with an
+ * increasing number of offspring in flight, on a MOBenchmark instance whose
+ * evaluations are slowed down by a LatencyObjective. Every run gets the
+ * same evaluation budget; at a quarter, half and all of it the normalised
+ * hypervolume (reference point: the nadir) and the elapsed time are
+ * printed. IncrementalSteadyStateMOCMA, which evaluates one offspring at
+ * a time, is the baseline. More offspring in flight finish the budget
+ * sooner, and the hypervolume shows what the stale parents cost per
+ * evaluation.
+ *
+ * Usage: bench_async_steady_state [problem] [dim] [evaluations] [median ms]
+ *                                 [max parallelism] [lognormal sigma]
+ */
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculator.h>
+#include <shark/Core/Random.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "algorithms/async_steady_state_mocma.h"
+#include "algorithms/steady_state_mocma.h"
+#include "moq/benchmarks.h"
+#include "moq/latency_objective.h"
+
+using namespace shark;
+
+template <typename Solution>
+double normalizedHypervolume(MOBenchmark const &benchmark, Solution const &solution) {
+    RealVector utopian = benchmark.utopian();
+    RealVector nadir = benchmark.nadir();
+    std::vector<RealVector> front;
+    for (auto const &s : solution) {
+        if (s.value(0) < nadir(0) && s.value(1) < nadir(1)) front.push_back(s.value);
+    }
+    HypervolumeCalculator hv;
+    return hv(front, nadir) / ((nadir(0) - utopian(0)) * (nadir(1) - utopian(1)));
+}
+
+template <typename Optimizer>
+void run(Optimizer &optimizer, std::string const &label, MOBenchmark const &benchmark, LatencyObjective &f, std::size_t budget) {
+    random::globalRng().seed(1);
+    f.init();
+    optimizer.mu() = 20;
+    optimizer.initialSigma() = 3.0;
+    optimizer.indicator().setReference(benchmark.nadir());
+    auto start = std::chrono::steady_clock::now();
+    optimizer.init(f);
+    std::cout << std::setw(10) << label;
+    for (std::size_t quarter : {1, 2, 4}) {
+        while (f.evaluationCounter() < budget * quarter / 4) optimizer.step(f);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "  " << std::setw(6) << f.evaluationCounter() << " evals " << std::setw(7) << elapsed.count() << " s hv " << normalizedHypervolume(benchmark, optimizer.solution());
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    std::string problem = argc > 1 ? argv[1] : "1/C";
+    unsigned int dim = argc > 2 ? std::atoi(argv[2]) : 10;
+    std::size_t budget = argc > 3 ? std::atoi(argv[3]) : 2000;
+    LatencyObjective::Latency latency;
+    latency.median = (argc > 4 ? std::atof(argv[4]) : 2.0) * 1e-3;
+    std::size_t maxParallelism = argc > 5 ? std::atoi(argv[5]) : 16;
+    latency.shape = argc > 6 ? std::atof(argv[6]) : 1.0;
+
+    MOBenchmark benchmark(problem, dim, 0);
+    LatencyObjective f(benchmark, latency);
+    std::cout << problem << " dim=" << dim << " evaluations=" << budget << " log-normal latency, median " << latency.median * 1e3 << " ms sigma " << latency.shape
+              << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+
+    IncrementalSteadyStateMOCMA sequential;
+    run(sequential, "sequential", benchmark, f, budget);
+    for (std::size_t p = 1; p <= maxParallelism; p *= 2) {
+        AsyncSteadyStateMOCMA optimizer;
+        optimizer.parallelism() = p;
+        run(optimizer, "P=" + std::to_string(p), benchmark, f, budget);
+    }
+}
@@ -0,0 +1,66 @@
+/* benchmark_fixed.cpp
+ *
+ * DESCRIPTION
+ * Evaluation throughput of MOBenchmark against the fixed size MOBenchmarkN
+ * returned by makeMOBenchmark(), for every specialised dimension, on the
+ * same uniformly drawn points. Also reports the largest relative
+ * difference of the objective values, which should be at rounding level.
+ *
+ * Usage: bench_benchmark_fixed [problem] [evaluations]
+ */
+#include <shark/Core/Random.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "moq/benchmark_fixed.h"
+
+using namespace shark;
+
+// microseconds per evaluation, cycling through points
+double timeEvaluations(MOBenchmark const &f, std::vector<RealVector> const &points, int evaluations, std::vector<RealVector> &values) {
+    values.resize(points.size());
+    auto start = std::chrono::steady_clock::now();
+    for (int e = 0; e != evaluations; e++) {
+        std::size_t i = e % points.size();
+        values[i] = f.eval(points[i]);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / evaluations;
+}
+
+int main(int argc, char *argv[]) {
+    std::string problem = argc > 1 ? argv[1] : "8/C";
+    int evaluations = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+    std::cout << std::fixed << std::setprecision(4);
+    std::cout << problem << " evaluations=" << evaluations << std::endl;
+    for (unsigned int dim : {2u, 3u, 5u, 10u, 20u, 40u}) {
+        MOBenchmark runtime(problem, dim, 0);
+        std::unique_ptr<MOBenchmark> fixed = makeMOBenchmark(problem, dim, 0);
+
+        random::globalRng().seed(1);
+        std::vector<RealVector> points(1024, RealVector(dim));
+        for (auto &point : points) {
+            for (std::size_t j = 0; j != dim; j++) point(j) = random::uni(random::globalRng(), -5.0, 5.0);
+        }
+
+        std::vector<RealVector> runtimeValues, fixedValues;
+        double runtimeTime = timeEvaluations(runtime, points, evaluations, runtimeValues);
+        double fixedTime = timeEvaluations(*fixed, points, evaluations, fixedValues);
+        double difference = 0.0;
+        for (std::size_t i = 0; i != points.size(); i++) {
+            for (std::size_t k = 0; k != 2; k++) difference = std::max(difference, std::abs(fixedValues[i](k) - runtimeValues[i](k)) / std::abs(runtimeValues[i](k)));
+        }
+
+        std::cout << "dim=" << std::setw(2) << dim << "  MOBenchmark " << runtimeTime << " us/eval  MOBenchmarkN " << fixedTime << " us/eval  "
+                  << runtimeTime / fixedTime << "x  max rel diff " << std::scientific << difference << std::fixed << std::endl;
+    }
+}
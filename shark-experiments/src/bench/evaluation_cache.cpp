@@ -0,0 +1,76 @@
+/* evaluation_cache.cpp
+ *
+ * DESCRIPTION
+ * How many evaluations of Shark's MO-CMA-ES and NSGA-II on a MOBenchmark
+ * instance are repeats of an earlier point, and what CachedObjective makes
+ * of them. Every optimizer runs three times from the same seed: on the
+ * plain instance, through the cache with Duplicates::Charged (which must
+ * reproduce the plain run and only skips recomputation) and with
+ * Duplicates::Free (where the budget buys distinct points only).
+ *
+ * Usage: bench_evaluation_cache [problem] [dim] [evaluations] [capacity]
+ */
+#include <shark/Algorithms/DirectSearch/MOCMA.h>
+#include <shark/Algorithms/DirectSearch/RealCodedNSGAII.h>
+#include <shark/Core/Random.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "moq/benchmarks.h"
+#include "moq/cached_objective.h"
+
+using namespace shark;
+
+// runs the optimizer on f until budget evaluations are charged, returns seconds
+template <class Function>
+double run(AbstractMultiObjectiveOptimizer<RealVector>& optimizer, Function& f, std::size_t budget, std::vector<RealVector>& values) {
+    random::globalRng().seed(1);
+    f.init();
+    auto start = std::chrono::steady_clock::now();
+    optimizer.init(f);
+    while (f.evaluationCounter() < budget) optimizer.step(f);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    values.clear();
+    for (auto const& s : optimizer.solution()) values.push_back(s.value);
+    return elapsed.count();
+}
+
+int main(int argc, char* argv[]) {
+    std::string problem = argc > 1 ? argv[1] : "1|C";
+    unsigned int dim = argc > 2 ? std::atoi(argv[2]) : 10;
+    std::size_t budget = argc > 3 ? std::atoi(argv[3]) : 100000;
+    std::size_t capacity = argc > 4 ? std::atoi(argv[4]) : 1 << 16;
+
+    MOBenchmark f(problem, dim, 0);
+    MOCMA mocma;
+    mocma.initialSigma() = 3.0;
+    mocma.mu() = 20;
+    RealCodedNSGAII nsga2;
+    nsga2.mu() = 20;
+    std::vector<AbstractMultiObjectiveOptimizer<RealVector>*> algos{&mocma, &nsga2};
+
+    std::cout << problem << " dim=" << dim << " evaluations=" << budget << " capacity=" << capacity << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (auto algo : algos) {
+        std::vector<RealVector> plainValues, chargedValues, freeValues;
+        double plain = run(*algo, f, budget, plainValues);
+
+        CachedObjective charged(f, capacity, CachedObjective::Duplicates::Charged);
+        double chargedTime = run(*algo, charged, budget, chargedValues);
+        bool same = chargedValues.size() == plainValues.size();
+        for (std::size_t i = 0; same && i != plainValues.size(); i++) same = chargedValues[i](0) == plainValues[i](0) && chargedValues[i](1) == plainValues[i](1);
+
+        CachedObjective uncharged(f, capacity, CachedObjective::Duplicates::Free);
+        double freeTime = run(*algo, uncharged, budget, freeValues);
+
+        EvaluationCache const& c = charged.cache();
+        std::cout << std::setw(8) << algo->name() << "  plain " << plain << " s  charged " << chargedTime << " s, " << 100.0 * c.hits() / (c.hits() + c.misses())
+                  << "% duplicates, " << c.evictions() << " evictions, " << (same ? "same run" : "DIFFERENT run") << "  free " << freeTime << " s, "
+                  << uncharged.cache().hits() << " duplicates on top of " << uncharged.evaluationCounter() << " evaluations" << std::endl;
+    }
+}
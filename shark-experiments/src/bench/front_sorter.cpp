@@ -0,0 +1,74 @@
+/* front_sorter.cpp
+ *
+ * DESCRIPTION
+ * Checks FrontSorter against shark::nonDominatedSort on random populations
+ * (continuous values, values on a coarse grid with many ties and
+ * duplicates, and points on a linear front) and reports the time of both
+ * for NSGA-II sized sorts of 2 mu points.
+ *
+ * Usage: bench_front_sorter [max mu]
+ */
+#include <shark/Algorithms/DirectSearch/Operators/Domination/NonDominatedSort.h>
+#include <shark/LinAlg/Base.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "algorithms/front_sorter.h"
+
+using namespace shark;
+
+std::vector<RealVector> population(std::mt19937 &rng, std::size_t size, std::size_t objectives, int kind) {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<RealVector> points(size, RealVector(objectives));
+    for (auto &point : points) {
+        double sum = 0.0;
+        for (std::size_t k = 0; k != objectives; k++) {
+            point(k) = kind == 1 ? static_cast<double>(rng() % 4) : uniform(rng);
+            sum += point(k);
+        }
+        if (kind == 2) point(objectives - 1) -= sum;
+    }
+    return points;
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t maxMu = argc > 1 ? std::atoi(argv[1]) : 10000;
+    std::mt19937 rng(42);
+    FrontSorter sorter;
+
+    for (int trial = 0; trial != 600; trial++) {
+        std::size_t objectives = 2 + trial % 4;
+        auto points = population(rng, rng() % 400, objectives, trial % 3);
+        std::vector<unsigned int> expected(points.size()), ranks(points.size());
+        nonDominatedSort(points, expected);
+        sorter(points, ranks);
+        if (ranks != expected) {
+            throw std::runtime_error("FrontSorter disagrees with shark::nonDominatedSort.");
+        }
+    }
+    std::cout << "600 random populations sorted identically" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (std::size_t objectives : {2, 3, 5}) {
+        for (std::size_t mu = 1000; mu <= maxMu; mu *= 10) {
+            auto points = population(rng, 2 * mu, objectives, 0);
+            std::vector<unsigned int> ranks(points.size());
+
+            auto start = std::chrono::steady_clock::now();
+            nonDominatedSort(points, ranks);
+            std::chrono::duration<double, std::milli> shark = std::chrono::steady_clock::now() - start;
+
+            start = std::chrono::steady_clock::now();
+            sorter(points, ranks);
+            std::chrono::duration<double, std::milli> ours = std::chrono::steady_clock::now() - start;
+
+            std::cout << "m=" << objectives << " 2mu=" << 2 * mu << "  shark " << shark.count() << " ms  FrontSorter " << ours.count() << " ms" << std::endl;
+        }
+    }
+}
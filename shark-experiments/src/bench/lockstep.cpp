@@ -0,0 +1,98 @@
+/* lockstep.cpp
+ *
+ * DESCRIPTION
+ * Throughput of LockstepMOCMA against running the same number of
+ * independent ParallelMOCMA runs (one thread) one after the other, on
+ * MOBenchmark instances of the size of the experiment_moq sweep. Reports
+ * the time per generation of a single run and the mean normalised
+ * hypervolume of both, which should agree up to noise.
+ *
+ * Usage: bench_lockstep [problem] [dim] [mu] [generations]
+ */
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculator.h>
+#include <shark/Core/Random.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "algorithms/lockstep_mocma.h"
+#include "algorithms/parallel_mocma.h"
+#include "moq/benchmark_lanes.h"
+
+using namespace shark;
+
+// dominated hypervolume w.r.t. the nadir point, relative to utopian-nadir box
+double normalisedHypervolume(MOBenchmark const &f, std::vector<RealVector> const &values) {
+    RealVector utopian = f.utopian();
+    RealVector nadir = f.nadir();
+    std::vector<RealVector> front;
+    for (auto const &v : values) {
+        if (v(0) < nadir(0) && v(1) < nadir(1)) front.push_back(v);
+    }
+    HypervolumeCalculator hv;
+    return hv(front, nadir) / ((nadir(0) - utopian(0)) * (nadir(1) - utopian(1)));
+}
+
+template <std::size_t Lanes>
+void compare(std::string const &problem, int dim, int mu, int generations) {
+    std::vector<std::unique_ptr<MOBenchmark>> instances;
+    std::vector<MOBenchmark const *> lanes;
+    for (std::size_t l = 0; l != Lanes; l++) {
+        instances.emplace_back(new MOBenchmark(problem, dim, l));
+        lanes.push_back(instances.back().get());
+    }
+
+    random::globalRng().seed(1);
+    double sequentialHv = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto &f : instances) {
+        ParallelMOCMA optimizer(1);
+        optimizer.mu() = mu;
+        optimizer.initialSigma() = 3.0;
+        f->init();
+        optimizer.init(*f);
+        for (int g = 0; g != generations; g++) optimizer.step(*f);
+        std::vector<RealVector> values;
+        for (auto const &solution : optimizer.solution()) values.push_back(solution.value);
+        sequentialHv += normalisedHypervolume(*f, values) / Lanes;
+    }
+    std::chrono::duration<double, std::micro> sequential = std::chrono::steady_clock::now() - start;
+
+    random::globalRng().seed(1);
+    MOBenchmarkLanes<Lanes> function(lanes);
+    LockstepMOCMA<Lanes> optimizer;
+    optimizer.mu() = mu;
+    optimizer.initialSigma() = 3.0;
+    start = std::chrono::steady_clock::now();
+    optimizer.init(function);
+    for (int g = 0; g != generations; g++) optimizer.step(function);
+    std::chrono::duration<double, std::micro> lockstep = std::chrono::steady_clock::now() - start;
+    double lockstepHv = 0.0;
+    for (std::size_t l = 0; l != Lanes; l++) {
+        std::vector<RealVector> points, values;
+        optimizer.solution(l, points, values);
+        lockstepHv += normalisedHypervolume(*instances[l], values) / Lanes;
+    }
+
+    double perRun = static_cast<double>(generations * Lanes);
+    std::cout << "lanes=" << std::setw(2) << Lanes << "  ParallelMOCMA " << sequential.count() / perRun << " us/gen (hv " << sequentialHv << ")  LockstepMOCMA "
+              << lockstep.count() / perRun << " us/gen (hv " << lockstepHv << ")  " << sequential.count() / lockstep.count() << "x" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    std::string problem = argc > 1 ? argv[1] : "8/C";
+    int dim = argc > 2 ? std::atoi(argv[2]) : 10;
+    int mu = argc > 3 ? std::atoi(argv[3]) : 20;
+    int generations = argc > 4 ? std::atoi(argv[4]) : 1000;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << problem << " dim=" << dim << " mu=" << mu << " generations=" << generations << std::endl;
+    compare<4>(problem, dim, mu, generations);
+    compare<8>(problem, dim, mu, generations);
+    compare<16>(problem, dim, mu, generations);
+}
@@ -0,0 +1,58 @@
+/* mocma_step.cpp
+ *
+ * DESCRIPTION
+ * Wall time per generation of Shark's MOCMA and of ParallelMOCMA for
+ * increasing thread counts on a high dimensional rotated problem.
+ *
+ * Usage: bench_mocma_step [n] [mu] [generations] [max threads]
+ */
+#include <shark/Algorithms/DirectSearch/MOCMA.h>
+#include <shark/Core/Random.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Benchmarks.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+#include "algorithms/parallel_mocma.h"
+
+using namespace shark;
+
+template <typename Optimizer>
+double millisecondsPerStep(Optimizer &optimizer, int n, int generations) {
+    benchmarks::ELLI1 fn(n);
+    fn.init();
+    optimizer.init(fn);
+    auto start = std::chrono::steady_clock::now();
+    for (int g = 0; g != generations; g++) {
+        optimizer.step(fn);
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / generations;
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 200;
+    int mu = argc > 2 ? std::atoi(argv[2]) : 100;
+    int generations = argc > 3 ? std::atoi(argv[3]) : 20;
+    int maxThreads = argc > 4 ? std::atoi(argv[4]) : std::thread::hardware_concurrency();
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "n=" << n << " mu=" << mu << " generations=" << generations << std::endl;
+
+    random::globalRng().seed(1);
+    MOCMA reference;
+    reference.mu() = mu;
+    double baseline = millisecondsPerStep(reference, n, generations);
+    std::cout << "MOCMA          " << baseline << " ms/step" << std::endl;
+
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        random::globalRng().seed(1);
+        ParallelMOCMA optimizer(threads);
+        optimizer.mu() = mu;
+        double time = millisecondsPerStep(optimizer, n, generations);
+        std::cout << "ParallelMOCMA  " << time << " ms/step with " << threads << " threads (" << baseline / time << "x)" << std::endl;
+    }
+}
@@ -0,0 +1,61 @@
+/* normal.cpp
+ *
+ * DESCRIPTION
+ * Time per standard normal deviate when filling buffers of the sizes the
+ * optimizers use (one mutation vector) and larger ones: std::mt19937 with
+ * std::normal_distribution element by element, as the optimizers did
+ * before, against Philox::normal(). Mean, variance and kurtosis of the
+ * bulk samples are printed as a sanity check (0, 1 and 3).
+ *
+ * Usage: bench_normal [samples]
+ */
+#include <stdlib.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "algorithms/philox.h"
+
+// nanoseconds per deviate for filling buffer over and over until samples are drawn
+template <typename Fill>
+double timeFill(std::vector<double>& buffer, long samples, Fill fill) {
+    long calls = samples / static_cast<long>(buffer.size()) + 1;
+    double sink = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (long c = 0; c != calls; c++) {
+        fill(buffer.data(), buffer.size());
+        sink += buffer[0];
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    if (sink == 12345.0) std::cout << sink;
+    return elapsed.count() / (calls * buffer.size());
+}
+
+int main(int argc, char* argv[]) {
+    long samples = argc > 1 ? std::atol(argv[1]) : 20000000;
+
+    std::cout << std::fixed << std::setprecision(2);
+    for (std::size_t n : {10, 40, 200, 10000}) {
+        std::vector<double> buffer(n);
+        std::mt19937 mt(1);
+        double sequential = timeFill(buffer, samples, [&](double* out, std::size_t m) {
+            std::normal_distribution<double> normal;
+            for (std::size_t i = 0; i != m; i++) out[i] = normal(mt);
+        });
+        Philox philox(1);
+        double bulk = timeFill(buffer, samples, [&](double* out, std::size_t m) { philox.normal(out, m); });
+        std::cout << "n=" << std::setw(5) << n << "  mt19937 + normal_distribution " << sequential << " ns  Philox::normal " << bulk << " ns  "
+                  << sequential / bulk << "x" << std::endl;
+    }
+
+    std::vector<double> values(samples);
+    Philox(2).normal(values.data(), values.size());
+    double mean = 0.0, variance = 0.0, kurtosis = 0.0;
+    for (double v : values) mean += v / samples;
+    for (double v : values) variance += (v - mean) * (v - mean) / samples;
+    for (double v : values) kurtosis += (v - mean) * (v - mean) * (v - mean) * (v - mean) / (samples * variance * variance);
+    std::cout << std::setprecision(4) << "mean " << mean << "  variance " << variance << "  kurtosis " << kurtosis << std::endl;
+}
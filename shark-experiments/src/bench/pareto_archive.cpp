@@ -0,0 +1,91 @@
+/* pareto_archive.cpp
+ *
+ * DESCRIPTION
+ * Throughput of ParetoArchive2D with an increasing number of writer
+ * threads, with and without a capacity, while one reader thread takes
+ * snapshots back to back and computes their hypervolume, as a checkpoint
+ * would. The candidates approach the front 1 - sqrt(f0) on [0, 1] from
+ * above, like the offspring of a converging run: most are dominated late
+ * in the run. Printed are the insert rate, how many candidates joined,
+ * were rejected or pruned, the final size, and how many snapshots the
+ * reader got through while the writers were busy.
+ *
+ * Usage: bench_pareto_archive [max writers] [candidates per writer] [capacity]
+ */
+#include <shark/LinAlg/Base.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "algorithms/philox.h"
+#include "parallel/pareto_archive.h"
+
+using namespace shark;
+
+// reference point (1, 1)
+double hypervolume(ParetoArchive2D::Snapshot const &snapshot) {
+    double hv = 0.0;
+    for (std::size_t i = 0; i != snapshot.size(); i++) {
+        double right = i + 1 != snapshot.size() ? snapshot.value(i + 1, 0) : 1.0;
+        hv += std::max(0.0, right - snapshot.value(i, 0)) * std::max(0.0, 1.0 - snapshot.value(i, 1));
+    }
+    return hv;
+}
+
+void run(std::size_t writers, std::size_t candidates, std::size_t capacity) {
+    ParetoArchive2D archive(capacity);
+    std::atomic<bool> done(false);
+    std::size_t snapshots = 0;
+    double hv = 0.0;
+    std::thread reader([&] {
+        while (!done.load(std::memory_order_acquire)) {
+            hv = hypervolume(archive.snapshot());
+            snapshots++;
+        }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t w = 0; w != writers; w++) {
+        threads.emplace_back([&, w] {
+            Philox rng(1, w);
+            std::uniform_real_distribution<double> uniform(0.0, 1.0);
+            RealVector point(10, 0.0), value(2);
+            for (std::size_t i = 0; i != candidates; i++) {
+                double u = uniform(rng);
+                double gap = std::exp(-10.0 * i / candidates) * uniform(rng);
+                point(0) = u;
+                value(0) = u;
+                value(1) = 1.0 - std::sqrt(u) + gap;
+                archive.insert(point, value);
+            }
+        });
+    }
+    for (auto &thread : threads) thread.join();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    done.store(true, std::memory_order_release);
+    reader.join();
+
+    std::cout << std::setw(3) << writers << " writers  " << std::setw(11) << writers * candidates / elapsed.count() << " inserts/s  " << std::setw(7) << archive.accepted()
+              << " joined " << std::setw(9) << archive.rejected() << " rejected " << std::setw(7) << archive.pruned() << " pruned  size " << std::setw(6) << archive.size()
+              << "  " << std::setw(7) << snapshots << " snapshots  hv " << hv << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t maxWriters = argc > 1 ? std::atoi(argv[1]) : 16;
+    std::size_t candidates = argc > 2 ? std::atoi(argv[2]) : 200000;
+    std::size_t capacity = argc > 3 ? std::atoi(argv[3]) : 100;
+
+    std::cout << std::fixed << std::setprecision(4);
+    for (std::size_t c : {std::size_t(0), capacity}) {
+        std::cout << (c ? "capacity " + std::to_string(c) : std::string("unbounded")) << ", " << candidates << " candidates per writer" << std::endl;
+        for (std::size_t writers = 1; writers <= maxWriters; writers *= 2) run(writers, candidates, c);
+    }
+}
@@ -0,0 +1,101 @@
+/* population_stream.cpp
+ *
+ * DESCRIPTION
+ * Round trip of the population snapshot stream. Runs Shark's MOCMA and
+ * SteadyStateMOCMA on ZDT1, records the solution of every generation both
+ * in memory and into a stream, reads the stream back and checks every
+ * frame bit for bit against the recorded snapshot. Printed are the stream
+ * size per frame and its ratio to the raw doubles.
+ *
+ * With "replay", reads a stream written by experiment_1 and prints its
+ * frames, e.g. to check a recording.
+ *
+ * Usage: bench_population_stream [n] [mu] [generations]
+ *        bench_population_stream replay <file>
+ */
+#include <shark/Algorithms/DirectSearch/MOCMA.h>
+#include <shark/Algorithms/DirectSearch/SteadyStateMOCMA.h>
+#include <shark/Core/Random.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Benchmarks.h>
+#include <stdlib.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "io/population_stream.h"
+
+using namespace shark;
+
+bool identical(std::vector<double> const &a, std::vector<double> const &b) { return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0); }
+
+template <typename Optimizer>
+void roundTrip(std::string const &label, int n, int mu, int generations) {
+    benchmarks::ZDT1 fn(n);
+    fn.init();
+    Optimizer optimizer;
+    optimizer.mu() = mu;
+    optimizer.init(fn);
+
+    std::string filename = "bench_population_stream.bin";
+    std::vector<PopulationSnapshot> snapshots;
+    double raw = 0;
+    {
+        PopulationStreamWriter writer(filename);
+        for (int g = 0; g <= generations; g++) {
+            if (g > 0) optimizer.step(fn);
+            snapshots.emplace_back();
+            snapshots.back().assign(g, fn.evaluationCounter(), optimizer.solution());
+            writer.write(snapshots.back());
+            raw += (snapshots.back().points.size() + snapshots.back().values.size()) * sizeof(double);
+        }
+        std::cout << std::fixed << std::setprecision(1) << label << "  " << writer.frames() << " frames  " << double(writer.bytesWritten()) / writer.frames() << " bytes/frame  "
+                  << std::setprecision(2) << raw / writer.bytesWritten() << "x smaller than raw" << std::endl;
+    }
+
+    PopulationStreamReader reader(filename);
+    PopulationSnapshot snapshot;
+    std::size_t frames = 0;
+    while (reader.read(snapshot)) {
+        PopulationSnapshot const &expected = snapshots.at(frames++);
+        if (snapshot.generation != expected.generation || snapshot.evaluations != expected.evaluations || snapshot.size != expected.size || !identical(snapshot.points, expected.points) ||
+            !identical(snapshot.values, expected.values)) {
+            throw std::runtime_error(label + ": frame " + std::to_string(frames - 1) + " differs from the recorded snapshot");
+        }
+    }
+    if (frames != snapshots.size()) {
+        throw std::runtime_error(label + ": stream ends after " + std::to_string(frames) + " of " + std::to_string(snapshots.size()) + " frames");
+    }
+    std::remove(filename.c_str());
+    std::cout << label << "  all frames identical" << std::endl;
+}
+
+void replay(std::string const &filename) {
+    PopulationStreamReader reader(filename);
+    PopulationSnapshot snapshot;
+    std::size_t frames = 0;
+    while (reader.read(snapshot)) {
+        std::cout << "generation " << snapshot.generation << "  " << snapshot.evaluations << " evals  " << snapshot.size << " x " << snapshot.numberOfVariables << " -> "
+                  << snapshot.numberOfObjectives << std::endl;
+        frames++;
+    }
+    std::cout << frames << " frames" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc > 2 && std::string(argv[1]) == "replay") {
+        replay(argv[2]);
+        return 0;
+    }
+    int n = argc > 1 ? std::atoi(argv[1]) : 30;
+    int mu = argc > 2 ? std::atoi(argv[2]) : 100;
+    int generations = argc > 3 ? std::atoi(argv[3]) : 500;
+
+    random::globalRng().seed(1);
+    roundTrip<MOCMA>("MOCMA           ", n, mu, generations);
+    roundTrip<SteadyStateMOCMA>("SteadyStateMOCMA", n, mu, generations);
+}
@@ -0,0 +1,66 @@
+/* steady_state.cpp
+ *
+ * DESCRIPTION
+ * Wall time per evaluation of Shark's SteadyStateMOCMA and of
+ * IncrementalSteadyStateMOCMA for increasing population sizes on a
+ * bi-objective problem, together with the hypervolume reached.
+ *
+ * Usage: bench_steady_state [n] [max mu] [evaluations per individual]
+ */
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculator.h>
+#include <shark/Algorithms/DirectSearch/SteadyStateMOCMA.h>
+#include <shark/Core/Random.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Benchmarks.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "algorithms/steady_state_mocma.h"
+
+using namespace shark;
+
+template <typename Optimizer>
+double microsecondsPerStep(Optimizer &optimizer, int n, int mu, int steps, double &volume) {
+    benchmarks::ZDT1 fn(n);
+    fn.init();
+    RealVector reference(2, 11.0);
+    optimizer.mu() = mu;
+    optimizer.indicator().setReference(reference);
+    optimizer.init(fn);
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s != steps; s++) {
+        optimizer.step(fn);
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::vector<RealVector> values;
+    for (auto const &solution : optimizer.solution()) values.push_back(solution.value);
+    HypervolumeCalculator hv;
+    volume = hv(values, reference);
+    return elapsed.count() / steps;
+}
+
+int main(int argc, char *argv[]) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 30;
+    int maxMu = argc > 2 ? std::atoi(argv[2]) : 1000;
+    int perIndividual = argc > 3 ? std::atoi(argv[3]) : 50;
+
+    std::cout << std::fixed << std::setprecision(3);
+    for (int mu = 10; mu <= maxMu; mu *= 10) {
+        int steps = mu * perIndividual;
+        double volume;
+
+        random::globalRng().seed(1);
+        SteadyStateMOCMA reference;
+        double baseline = microsecondsPerStep(reference, n, mu, steps, volume);
+        std::cout << "mu=" << mu << "  SteadyStateMOCMA            " << baseline << " us/eval  hv " << volume << std::endl;
+
+        random::globalRng().seed(1);
+        IncrementalSteadyStateMOCMA optimizer;
+        double time = microsecondsPerStep(optimizer, n, mu, steps, volume);
+        std::cout << "mu=" << mu << "  IncrementalSteadyStateMOCMA " << time << " us/eval  hv " << volume << " (" << baseline / time << "x)" << std::endl;
+    }
+}
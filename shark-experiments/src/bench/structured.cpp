@@ -0,0 +1,110 @@
+/* structured.cpp
+ *
+ * DESCRIPTION
+ * Construction and evaluation time of StructuredMOBenchmark for all 54
+ * problem classes with block-diagonal and Householder rotations, together
+ * with the properties the classes rely on: the rotations are orthogonal,
+ * delta = x_2^* - x_1^* is a generalised eigenvector of (H_1, H_2) (the
+ * sine of the angle between H_1 delta and H_2 delta vanishes), and delta is
+ * a coordinate axis for aligned classes.
+ *
+ * Usage: bench_structured [dim] [block size] [reflectors] [evaluations]
+ */
+#include <shark/Core/Random.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "moq/structured_benchmark.h"
+
+using namespace shark;
+
+// H delta = U diag(D) U^T delta
+std::vector<double> hessianTimes(ImplicitRotation const &U, RealVector const &D, std::vector<double> const &delta) {
+    std::vector<double> y(delta.size()), ret(delta.size());
+    U.applyTranspose(delta.data(), y.data());
+    for (std::size_t i = 0; i != y.size(); i++) y[i] *= D(i);
+    U.apply(y.data(), ret.data());
+    return ret;
+}
+
+// |U U^T x - x|_inf for a random x
+double orthogonalityError(ImplicitRotation const &U) {
+    std::size_t n = U.dimension();
+    std::vector<double> x(n), y(n), z(n);
+    for (auto &e : x) e = random::gauss(random::globalRng(), 0.0, 1.0);
+    U.applyTranspose(x.data(), y.data());
+    U.apply(y.data(), z.data());
+    double ret = 0.0;
+    for (std::size_t i = 0; i != n; i++) ret = std::max(ret, std::abs(z[i] - x[i]));
+    return ret;
+}
+
+void run(StructuredMOBenchmark::Structure structure, unsigned int size, unsigned int dim, int evaluations) {
+    char const *problemchar = "123456789";
+    char const *alignchar = "|/";
+    char const *shapechar = "CIJ";
+    double construction = 0.0, evaluation = 0.0, orthogonality = 0.0, eigen = 0.0, alignment = 0.0;
+    for (int problem = 0; problem < 9; problem++) {
+        for (int align = 0; align < 2; align++) {
+            for (int shape = 0; shape < 3; shape++) {
+                std::string name{problemchar[problem], alignchar[align], shapechar[shape]};
+                auto start = std::chrono::steady_clock::now();
+                StructuredMOBenchmark f(name, dim, 0, structure, size);
+                std::chrono::duration<double, std::milli> built = std::chrono::steady_clock::now() - start;
+                construction += built.count() / 54;
+
+                RealVector x = f.proposeStartingPoint();
+                double sum = 0.0;
+                start = std::chrono::steady_clock::now();
+                for (int e = 0; e != evaluations; e++) {
+                    x(e % dim) += 0.1;
+                    sum += f.eval(x)(0);
+                }
+                std::chrono::duration<double, std::micro> evaluated = std::chrono::steady_clock::now() - start;
+                evaluation += evaluated.count() / evaluations / 54;
+                if (!std::isfinite(sum)) std::cout << "non-finite value for " << name << std::endl;
+
+                orthogonality = std::max({orthogonality, orthogonalityError(f.U1()), orthogonalityError(f.U2())});
+                std::vector<double> delta(dim);
+                for (unsigned int i = 0; i != dim; i++) delta[i] = f.x2star()(i) - f.x1star()(i);
+                std::vector<double> h1 = hessianTimes(f.U1(), f.D1(), delta);
+                std::vector<double> h2 = hessianTimes(f.U2(), f.D2(), delta);
+                double n1 = 0.0, n2 = 0.0, dot = 0.0;
+                for (unsigned int i = 0; i != dim; i++) {
+                    n1 += h1[i] * h1[i];
+                    n2 += h2[i] * h2[i];
+                    dot += h1[i] * h2[i];
+                }
+                double cosine = dot / std::sqrt(n1 * n2);
+                eigen = std::max(eigen, std::sqrt(std::max(0.0, 1.0 - cosine * cosine)));
+                if (align == 0) {
+                    double largest = 0.0;
+                    for (double e : delta) largest = std::max(largest, std::abs(e));
+                    alignment = std::max(alignment, 1.0 - largest);
+                }
+            }
+        }
+    }
+    std::cout << (structure == StructuredMOBenchmark::Structure::BlockDiagonal ? "block-diagonal b=" : "householder    k=") << std::setw(3) << size
+              << "  construction " << std::fixed << std::setprecision(2) << construction << " ms  eval " << evaluation << " us" << std::scientific
+              << std::setprecision(1) << "  |UU^T-I| " << orthogonality << "  sin(H1 d, H2 d) " << eigen << "  aligned 1-|d|_inf " << alignment << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    unsigned int dim = argc > 1 ? std::atoi(argv[1]) : 10000;
+    unsigned int blockSize = argc > 2 ? std::atoi(argv[2]) : 16;
+    unsigned int reflectors = argc > 3 ? std::atoi(argv[3]) : 8;
+    int evaluations = argc > 4 ? std::atoi(argv[4]) : 100;
+
+    random::globalRng().seed(1);
+    std::cout << "dim=" << dim << " evaluations=" << evaluations << std::endl;
+    run(StructuredMOBenchmark::Structure::BlockDiagonal, blockSize, dim, evaluations);
+    run(StructuredMOBenchmark::Structure::Householder, reflectors, dim, evaluations);
+}
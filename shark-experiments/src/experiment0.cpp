@@ -2,6 +2,13 @@
  *
  * DESCRIPTION
  * Creates plots for visualizing some population plots.
+ * The figures are rendered in the embedded interpreter by default, or
+ * handed to scripts/plot_worker.py when the backend argument is "queue".
+ * The "native" backend draws the figure in process without Python. The
+ * eleventh argument selects PNG (default) or SVG for every backend. The
+ * fifth argument selects Shark's SteadyStateMOCMA ("steady"), the
+ * IncrementalSteadyStateMOCMA of this repository ("incremental") or
+ * Shark's MOCMA (anything else).
  *
  * REFERENCES
  * - https://git.io/JIKs7
@@ -18,9 +25,16 @@
 #include <boost/format.hpp>
 #include <ios>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
 
+#include "algorithms/steady_state_mocma.h"
 #include "matplotlibcpp/matplotlibcpp.h"
 #include "moq/benchmarks.h"
+#include "plotting/plot_queue.h"
+#include "plotting/plot_spec.h"
+#include "plotting/raster.h"
 
 using namespace shark;
 
@@ -42,12 +56,14 @@ struct PointExtractor {
 template <typename Optimizer = MOCMA>
 class PopulationPlotExperiment {
    public:
-    static void run(int seed, int mu, int n, int maxEvaluations, RealVector *reference = nullptr, bool individual = false, std::string extra = "1|C", int instance = 1, std::size_t maxTrials = 3) {
+    static PlotSpec run(int seed, int mu, int n, int maxEvaluations, RealVector *reference = nullptr, bool individual = false, std::string extra = "1|C", int instance = 1, std::size_t maxTrials = 3) {
         random::globalRng().seed(seed);
         std::cout.setf(std::ios_base::scientific);
         std::cout.precision(10);
         std::vector<std::string> formats = {"xb", "xg", "xy"};
-        plt::figure_size(500, 350);
+        PlotSpec figure;
+        figure.width = 500;
+        figure.height = 350;
 
         std::string st = individual ? "I" : "P";
         auto nTrials = std::min(formats.size(), maxTrials);
@@ -63,7 +79,7 @@ class PopulationPlotExperiment {
 
             /*if (i == 0) {
                 auto [frontY1, frontY2] = fn.paretoFront(50);
-                plt::plot(frontY1, frontY2, "r-");
+                figure.plot(frontY1, frontY2, "r-");
             }*/
 
             Optimizer optimizer;
@@ -87,12 +103,14 @@ class PopulationPlotExperiment {
 
             auto solution = optimizer.solution();
             int size = solution.size();
-            std::vector<double> x(size), y(size);
+            // one row per individual, the series are views of its columns
+            auto front = std::make_shared<RealMatrix>(size, 2);
             for (int i = 0; i != size; i++) {
-                x[i] = solution[i].value[0];
-                y[i] = solution[i].value[1];
+                row(*front, i) = solution[i].value;
+            }
+            if (size > 0) {
+                figure.plot(PlotColumn(front, &(*front)(0, 0), size, 2), PlotColumn(front, &(*front)(0, 1), size, 2), formats[i]);
             }
-            plt::plot(x, y, formats[i]);
 
             if (reference != nullptr) {
                 HypervolumeCalculator hyp;
@@ -100,31 +118,72 @@ class PopulationPlotExperiment {
                 std::cout << "Trial " << i << ": " << volume << std::endl;
             }
             if (i + 1 == nTrials) {
-                plt::title(boost::str(boost::format("%1%(n=%2%), %3%-%4%\nmu=%5%,evals=%6%") % fn.name() % n % optimizer.name() % st % mu % fn.evaluationCounter()));
-                plt::save(boost::str(boost::format("./%1%n%2%-%3%-%4%-mu%5%-fe%6%-seed%7%.png") % safe_name(fn.name()) % n % optimizer.name() % st % mu % fn.evaluationCounter() % seed));
+                figure.title = boost::str(boost::format("%1%(n=%2%), %3%-%4%\nmu=%5%,evals=%6%") % fn.name() % n % optimizer.name() % st % mu % fn.evaluationCounter());
+                figure.filename = boost::str(boost::format("./%1%n%2%-%3%-%4%-mu%5%-fe%6%-seed%7%.png") % safe_name(fn.name()) % n % optimizer.name() % st % mu % fn.evaluationCounter() % seed);
             }
         }
+        return figure;
     }
 };
 
+plt::array_view<double> view(PlotColumn const &column) {
+    return plt::array_view<double>{column.data(), column.size(), column.stride(), column.owner()};
+}
+
+// render in the embedded interpreter, the arrays share the series' buffers
+void render(PlotSpec const &figure) {
+    plt::figure_size(figure.width, figure.height);
+    for (auto const &series : figure.series) {
+        plt::plot(view(series.x), view(series.y), series.format);
+    }
+    plt::title(figure.title);
+    plt::save(figure.filename);
+}
+
 int main(int argc, char *argv[]) {
     int seed = argc > 1 ? std::atoi(argv[1]) : 0;
     int mu = argc > 2 ? std::atoi(argv[2]) : 10;
     int n = argc > 3 ? std::atoi(argv[3]) : 5;
     int maxEvaluations = argc > 4 ? std::atoi(argv[4]) : 5000;
     bool useSteadyState = argc > 5 ? std::strcmp("steady", argv[5]) == 0 : false;
+    bool useIncremental = argc > 5 ? std::strcmp("incremental", argv[5]) == 0 : false;
     bool individual = argc > 6 ? std::strcmp("individual", argv[6]) == 0 : false;
     std::string extra = argc > 7 ? std::string(argv[7]) : "1|C";
     int instance = argc > 8 ? std::atoi(argv[8]) : rand();
+    std::string backend = argc > 9 ? std::string(argv[9]) : "matplotlib";
+    std::string spool = argc > 10 ? std::string(argv[10]) : "plot-spool";
+    std::string format = argc > 11 ? std::string(argv[11]) : "png";
+    if (format != "png" && format != "svg") {
+        throw std::runtime_error("Unknown image format: " + format);
+    }
 
     RealVector reference = {11.0, 11.0};
     RealVector *reference_ptr = nullptr;
     std::size_t maxTrials = 1;
+    PlotSpec figure;
     if (useSteadyState) {
         PopulationPlotExperiment<SteadyStateMOCMA> experiment;
-        experiment.run(seed, mu, n, maxEvaluations, reference_ptr, individual, extra, instance, maxTrials);
+        figure = experiment.run(seed, mu, n, maxEvaluations, reference_ptr, individual, extra, instance, maxTrials);
+    } else if (useIncremental) {
+        PopulationPlotExperiment<IncrementalSteadyStateMOCMA> experiment;
+        figure = experiment.run(seed, mu, n, maxEvaluations, reference_ptr, individual, extra, instance, maxTrials);
     } else {
         PopulationPlotExperiment<MOCMA> experiment;
-        experiment.run(seed, mu, n, maxEvaluations, reference_ptr, individual, extra, instance, maxTrials);
+        figure = experiment.run(seed, mu, n, maxEvaluations, reference_ptr, individual, extra, instance, maxTrials);
+    }
+    // every backend picks the format from the extension
+    figure.filename.replace(figure.filename.size() - 3, 3, format);
+
+    if (backend == "queue") {
+        PlotQueue queue(spool);
+        queue.submit(std::move(figure));
+        queue.flush();
+        std::cout << "Queued plot in " << queue.spoolDirectory() << std::endl;
+    } else if (backend == "matplotlib") {
+        render(figure);
+    } else if (backend == "native") {
+        renderNative(figure);
+    } else {
+        throw std::runtime_error("Unknown plot backend: " + backend);
     }
 }
@@ -19,19 +19,36 @@ using namespace shark;
 
 // STL
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <ios>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <filesystem>
+#include <type_traits>
 namespace fs = std::filesystem;
 
 // Boost
 #include <boost/format.hpp>
 
+// Project
+#include "io/checkpoint.h"
+#include "io/population_stream.h"
+#include "algorithms/front_sorting_nsga2.h"
+#include "algorithms/parallel_mocma.h"
+#include "algorithms/steady_state_mocma.h"
+#include "io/run_cache.h"
+#include "parallel/fork_branches.h"
+
 std::string name(std::string name, int mu, bool individualBased) {
     std::string suffix = individualBased ? "I" : "P";
     if (name == "SteadyStateMOCMA") {
         return boost::str(boost::format("(%1%+1)-MO-CMA-ES-%2%") % mu % suffix);
+    } else if (name == "IncrementalSteadyStateMOCMA") {
+        return boost::str(boost::format("(%1%+1)-MO-CMA-ES-%2%-incremental") % mu % suffix);
+    } else if (name == "ParallelMOCMA") {
+        return boost::str(boost::format("(%1%+%1%)-MO-CMA-ES-%2%-parallel") % mu % suffix);
     } else {
         return boost::str(boost::format("(%1%+%1%)-MO-CMA-ES-%2%") % mu % suffix);
     }
@@ -39,13 +56,75 @@ std::string name(std::string name, int mu, bool individualBased) {
 
 auto constexpr SEED = 3498;  // using random.org
 
+// Record the population of every generation into a snapshot stream.
+static bool streamPopulation = false;
+// Save a checkpoint of every trial at every budget milestone.
+static bool saveCheckpoints = false;
+// Continue every trial from its checkpoint, if there is one.
+static bool resumeTrials = false;
+// Fork the MO-CMA-ES trials after their budget into continuations.
+static bool branchTrials = false;
+// Run the (mu+mu)-MO-CMA-ES trials with ParallelMOCMA on all hardware
+// threads instead of Shark's MOCMA.
+static bool parallelMOCMA = false;
+// Run the NSGA-II trials with FrontSortingNSGAII, which takes the same
+// steps as Shark's NSGA-II with faster non-dominated sorting.
+static bool frontSorting = false;
+// Run the bi-objective (mu+1)-MO-CMA-ES trials with
+// IncrementalSteadyStateMOCMA instead of Shark's SteadyStateMOCMA.
+static bool incrementalSteadyState = false;
+// Seed every trial from its configuration and reuse the files of trials
+// with the same configuration; nullptr for the single seeded sequence.
+static RunCache *runCache = nullptr;
+
+// Step size factors of the continuations, each with either notion of success.
+constexpr double BRANCH_SIGMA_FACTORS[] = {0.5, 1.0, 2.0};
+// Evaluations of every continuation.
+constexpr std::size_t BRANCH_EVALUATIONS = 50000;
+
+// Shark keeps the parents of its MO-CMA-ES variants protected; a
+// continuation rescales their step sizes through this derived class.
+template <class Optimizer>
+class Branchable : public Optimizer {
+   public:
+    void scaleStepSizes(double factor) {
+        for (auto &individual : this->m_parents) {
+            individual.chromosome().m_stepSize *= factor;
+        }
+    }
+};
+
 template <class ObjectiveFunction, class Optimizer, bool individualBased, bool mocmaBased = true>
 class RunTrials {
+    // Shark's MO-CMA-ES variants, whose parents a continuation can rescale
+    static constexpr bool branchable = mocmaBased && !std::is_same<Optimizer, ParallelMOCMA>::value && !std::is_same<Optimizer, IncrementalSteadyStateMOCMA>::value;
+
    public:
     static void run(int mu, double initialSigma, int nObjectives, int nVariables, int nTrials, RealVector *reference = nullptr) {
+        if constexpr (std::is_same<Optimizer, MOCMA>::value) {
+            if (parallelMOCMA) {
+                RunTrials<ObjectiveFunction, ParallelMOCMA, individualBased, mocmaBased>::run(mu, initialSigma, nObjectives, nVariables, nTrials, reference);
+                return;
+            }
+        }
+        if constexpr (std::is_same<Optimizer, SteadyStateMOCMA>::value) {
+            if (incrementalSteadyState && nObjectives == 2) {
+                RunTrials<ObjectiveFunction, IncrementalSteadyStateMOCMA, individualBased, mocmaBased>::run(mu, initialSigma, nObjectives, nVariables, nTrials, reference);
+                return;
+            }
+        }
+        if constexpr (std::is_same<Optimizer, IndicatorBasedRealCodedNSGAII<HypervolumeIndicator>>::value) {
+            if (frontSorting) {
+                RunTrials<ObjectiveFunction, FrontSortingNSGAII<Optimizer>, individualBased, mocmaBased>::run(mu, initialSigma, nObjectives, nVariables, nTrials, reference);
+                return;
+            }
+        }
         for (auto t = 0; t < nTrials; ++t) {
-            Optimizer opt;
-            ObjectiveFunction fn(nVariables);
+            std::conditional_t<branchable, Branchable<Optimizer>, Optimizer> opt;
+            if constexpr (std::is_same<Optimizer, ParallelMOCMA>::value) {
+                opt.setThreads(0);
+            }
+            Resumable<ObjectiveFunction> fn(nVariables);
 
             if (fn.hasScalableObjectives()) {
                 fn.setNumberOfObjectives(nObjectives);
@@ -74,57 +153,201 @@ class RunTrials {
                 opt.indicator().setReference(*reference);
             }
 
+            std::string optName;
+            if constexpr (mocmaBased) {
+                optName = name(opt.name(), mu, individualBased);
+            } else {
+                optName = std::string("NSGAII");
+            }
+
+            RunKey key;
+            key.add("experiment", "1").add("function", fn.name()).add("variables", fn.numberOfVariables()).add("objectives", fn.numberOfObjectives());
+            key.add("optimizer", optName);
+            if constexpr (mocmaBased) {
+                key.add("sigma", initialSigma);
+            }
+            if (reference != nullptr) {
+                for (std::size_t i = 0; i != reference->size(); i++) {
+                    key.add("reference" + std::to_string(i), (*reference)(i));
+                }
+            }
+            key.add("budget", 50000).add("trial", t + 1).add("seed", SEED).add("observation", "fitness every 5000 evaluations");
+            RunCache::Outputs outputs;
+            if (runCache) {
+                if (runCache->load(key, outputs)) {
+                    for (auto const &output : outputs) {
+                        std::cout << "Writing file: " << output.first << " (cached)" << std::endl;
+                        std::ofstream logfile(output.first);
+                        logfile << output.second;
+                    }
+                    continue;
+                }
+                random::globalRng().seed(key.seed());
+            }
+
             fn.init();
             opt.init(fn);
 
+            // the checkpoint holds the generator state after the trial, so
+            // the trials after it start as in an uninterrupted run
             int nextEvaluationsLimit = 0;
+            auto checkpointname = boost::str(boost::format("output/%1%_%2%_%3%.checkpoint") % fn.name() % optName % (t + 1));
+            if (resumeTrials && fs::exists(checkpointname)) {
+                CheckpointInfo info = loadCheckpoint(checkpointname, opt);
+                fn.setEvaluationCounter(info.evaluations);
+                nextEvaluationsLimit = info.step;
+                std::cout << "Resuming from: " << checkpointname << " at " << info.evaluations << " evaluations" << std::endl;
+            }
+
+            std::unique_ptr<PopulationStreamWriter> stream;
+            std::uint64_t generation = 0;
+            if (streamPopulation) {
+                auto streamname = boost::str(boost::format("output/%1%_%2%_%3%.population.bin") % fn.name() % optName % (t + 1));
+                std::cout << "Streaming population: " << streamname << std::endl;
+                stream = std::make_unique<PopulationStreamWriter>(streamname);
+                stream->write(generation, fn.evaluationCounter(), opt.solution());
+            }
+
             while (nextEvaluationsLimit < 50001) {
-                std::string optName;
-                if constexpr (mocmaBased) {
-                    optName = name(opt.name(), mu, individualBased);
-                } else {
-                    optName = std::string("NSGAII");
-                }
                 auto filename = boost::str(boost::format("output/%1%_%2%_%3%_%4%.fitness.csv") % fn.name() % optName % (t + 1) % nextEvaluationsLimit);
                 std::cout << "Writing file: " << filename << std::endl;
+                std::ostringstream text;
+                writeFitness(text, fn, optName, t, opt.solution());
                 std::ofstream logfile;
                 logfile.open(filename);
-                logfile << std::setprecision(10);
-                logfile << "# Generated with Shark 4.1.x\n";
-                logfile << "# Global seed: " << SEED << "\n";
-                logfile << "# Function: " << fn.name() << ": " << fn.numberOfVariables() << " -> " << fn.numberOfObjectives() << "\n";
-                logfile << "# Optimizer: " << optName << "\n";
-                logfile << "# Trial: " << (t + 1) << "\n";
-                logfile << "# Evaluations: " << fn.evaluationCounter() << "\n";
-                logfile << "# Observation: fitness\n";
-
-                const auto solution = opt.solution();
-                const auto size = solution.size();
-                for (auto i = 0; i < size; ++i) {
-                    const auto &value = solution[i].value;
-                    for (auto j = 0; j < value.size(); ++j) {
-                        logfile << value[j];
-                        if (j != value.size() - 1) {
-                            logfile << ",";
-                        }
-                    }
-                    logfile << "\n";
-                }
+                logfile << text.str();
                 logfile.close();
+                if (runCache) {
+                    outputs[filename] = text.str();
+                }
                 nextEvaluationsLimit += 5000;
 
                 while (fn.evaluationCounter() < nextEvaluationsLimit) {
                     opt.step(fn);
+                    if (stream) {
+                        stream->write(++generation, fn.evaluationCounter(), opt.solution());
+                    }
+                }
+                if (saveCheckpoints) {
+                    saveCheckpoint(checkpointname, opt, fn.evaluationCounter(), nextEvaluationsLimit);
+                }
+            }
+
+            if (runCache) {
+                runCache->store(key, outputs);
+            }
+
+            if constexpr (branchable) {
+                if (branchTrials) {
+                    branch(opt, fn, optName, t);
                 }
             }
         }
     }
+
+   private:
+    static void writeFitness(std::ostream &logfile, ObjectiveFunction const &fn, std::string const &optName, int t, typename Optimizer::SolutionType const &solution) {
+        logfile << std::setprecision(10);
+        logfile << "# Generated with Shark 4.1.x\n";
+        logfile << "# Global seed: " << SEED << "\n";
+        logfile << "# Function: " << fn.name() << ": " << fn.numberOfVariables() << " -> " << fn.numberOfObjectives() << "\n";
+        logfile << "# Optimizer: " << optName << "\n";
+        logfile << "# Trial: " << (t + 1) << "\n";
+        logfile << "# Evaluations: " << fn.evaluationCounter() << "\n";
+        logfile << "# Observation: fitness\n";
+
+        const auto size = solution.size();
+        for (auto i = 0; i < size; ++i) {
+            const auto &value = solution[i].value;
+            for (auto j = 0; j < value.size(); ++j) {
+                logfile << value[j];
+                if (j != value.size() - 1) {
+                    logfile << ",";
+                }
+            }
+            logfile << "\n";
+        }
+    }
+
+    // Continues the trial once for every notion of success and step size
+    // factor, each in a child process that shares the state after the
+    // prefix copy-on-write. All branches draw the same random numbers.
+    static void branch(Branchable<Optimizer> &opt, ObjectiveFunction &fn, std::string const &optName, int t) {
+        constexpr std::size_t nFactors = sizeof(BRANCH_SIGMA_FACTORS) / sizeof(BRANCH_SIGMA_FACTORS[0]);
+        auto label = [&](std::size_t i) {
+            return boost::str(boost::format("%1%-x%2%") % (i < nFactors ? "I" : "P") % BRANCH_SIGMA_FACTORS[i % nFactors]);
+        };
+        std::size_t prefix = fn.evaluationCounter();
+        auto reports = forkBranches(2 * nFactors, [&](std::size_t i, std::ostream &report) {
+            if (i < nFactors) {
+                opt.notionOfSuccess() = Optimizer::NotionOfSuccess::IndividualBased;
+            } else {
+                opt.notionOfSuccess() = Optimizer::NotionOfSuccess::PopulationBased;
+            }
+            opt.scaleStepSizes(BRANCH_SIGMA_FACTORS[i % nFactors]);
+            while (fn.evaluationCounter() < prefix + BRANCH_EVALUATIONS) {
+                opt.step(fn);
+            }
+            writeFitness(report, fn, optName + " branch " + label(i), t, opt.solution());
+        });
+        for (std::size_t i = 0; i != reports.size(); i++) {
+            auto filename = boost::str(boost::format("output/%1%_%2%_%3%_branch_%4%.fitness.csv") % fn.name() % optName % (t + 1) % label(i));
+            std::cout << "Writing file: " << filename << std::endl;
+            std::ofstream logfile(filename);
+            logfile << reports[i];
+        }
+    }
 };
 
 /* 
  * Create the experiment data according to sec. 4.1 of [2010:mo-cma-es].
+ * Pass "stream" to additionally record every generation, "checkpoint" to
+ * save the state of every trial every 5000 evaluations, and "resume" to
+ * keep the output directory and continue each trial from its checkpoint
+ * (the population stream of a resumed trial starts at the checkpoint).
+ * Pass "branch" to continue every MO-CMA-ES trial after its budget with
+ * each notion of success and step size factor, in forked processes.
+ * Pass "parallel" to run the (mu+mu)-MO-CMA-ES trials with ParallelMOCMA,
+ * which spreads each generation over all hardware threads; it pays off at
+ * a few hundred variables (see bench_mocma_step).
+ * Pass "frontsort" to run the NSGA-II trials with FrontSortingNSGAII; the
+ * results are the same, and so are their run cache entries.
+ * Pass "incremental" to run the bi-objective (mu+1)-MO-CMA-ES trials with
+ * IncrementalSteadyStateMOCMA.
+ * Pass "cache" to seed every trial from its configuration and take the
+ * files of trials computed before from the run cache; it cannot be
+ * combined with the other options.
  */
-int main() {
+int main(int argc, char *argv[]) {
+    bool useCache = false;
+    for (int i = 1; i < argc; i++) {
+        streamPopulation = streamPopulation || std::strcmp("stream", argv[i]) == 0;
+        saveCheckpoints = saveCheckpoints || std::strcmp("checkpoint", argv[i]) == 0;
+        resumeTrials = resumeTrials || std::strcmp("resume", argv[i]) == 0;
+        branchTrials = branchTrials || std::strcmp("branch", argv[i]) == 0;
+        parallelMOCMA = parallelMOCMA || std::strcmp("parallel", argv[i]) == 0;
+        frontSorting = frontSorting || std::strcmp("frontsort", argv[i]) == 0;
+        incrementalSteadyState = incrementalSteadyState || std::strcmp("incremental", argv[i]) == 0;
+        useCache = useCache || std::strcmp("cache", argv[i]) == 0;
+    }
+    // a trial taken from the cache is not run, so there is nothing to
+    // stream, checkpoint, resume or branch
+    if (useCache && (streamPopulation || saveCheckpoints || resumeTrials || branchTrials)) {
+        throw std::runtime_error("cache cannot be combined with stream, checkpoint, resume or branch.");
+    }
+    // ParallelMOCMA has no serialisation and no accessible parents
+    if (parallelMOCMA && (saveCheckpoints || resumeTrials || branchTrials)) {
+        throw std::runtime_error("parallel cannot be combined with checkpoint, resume or branch.");
+    }
+    // neither has IncrementalSteadyStateMOCMA
+    if (incrementalSteadyState && (saveCheckpoints || resumeTrials || branchTrials)) {
+        throw std::runtime_error("incremental cannot be combined with checkpoint, resume or branch.");
+    }
+    RunCache cache("run-cache");
+    if (useCache) {
+        runCache = &cache;
+    }
+
     RealVector reference = {11.0, 11.0};
     RealVector *referencePtr = nullptr;
 
@@ -135,8 +358,10 @@ int main() {
 
     random::globalRng().seed(SEED);
 
-    std::cout << "Removing ouput directory" << std::endl;
-    fs::remove_all("output");
+    if (!resumeTrials) {
+        std::cout << "Removing ouput directory" << std::endl;
+        fs::remove_all("output");
+    }
     std::cout << "Creating output directory" << std::endl;
     fs::create_directory("output");
 
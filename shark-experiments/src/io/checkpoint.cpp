@@ -0,0 +1,94 @@
+/* checkpoint.cpp
+ *
+ * DESCRIPTION
+ * Writer and reader for optimizer checkpoints, see io/checkpoint.h for the
+ * format. The generator state is taken from its stream operators, which
+ * the standard defines to round-trip it exactly; the integers of the text
+ * form are stored as binary words.
+ */
+#include "io/checkpoint.h"
+
+#include <shark/Core/Random.h>
+
+#include <algorithm>
+#include <boost/archive/polymorphic_binary_iarchive.hpp>
+#include <boost/archive/polymorphic_binary_oarchive.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr char MAGIC[4] = {'C', 'K', 'P', 'T'};
+constexpr unsigned char VERSION = 1;
+
+std::vector<std::uint64_t> generatorState() {
+    std::stringstream text;
+    text << shark::random::globalRng();
+    std::vector<std::uint64_t> state;
+    std::uint64_t word;
+    while (text >> word) state.push_back(word);
+    return state;
+}
+
+bool setGeneratorState(std::vector<std::uint64_t> const& state) {
+    std::stringstream text;
+    for (std::uint64_t word : state) text << word << ' ';
+    text >> shark::random::globalRng();
+    return !text.fail();
+}
+
+}  // namespace
+
+void saveCheckpoint(std::string const& filename, shark::AbstractMultiObjectiveOptimizer<shark::RealVector> const& optimizer, std::uint64_t evaluations,
+                    std::uint64_t step) {
+    std::string temporary = filename + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Failed to open file: " + temporary);
+        }
+        out.write(MAGIC, sizeof(MAGIC));
+        out.put(static_cast<char>(VERSION));
+
+        std::string name = optimizer.name();
+        std::vector<std::uint64_t> state = generatorState();
+        boost::archive::polymorphic_binary_oarchive archive(out, boost::archive::no_header);
+        archive << name << evaluations << step << state;
+        optimizer.write(archive);
+        if (!out) {
+            throw std::runtime_error("Failed to write checkpoint: " + temporary);
+        }
+    }
+    if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        throw std::runtime_error("Failed to replace checkpoint: " + filename);
+    }
+}
+
+CheckpointInfo loadCheckpoint(std::string const& filename, shark::AbstractMultiObjectiveOptimizer<shark::RealVector>& optimizer) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+    char magic[sizeof(MAGIC)];
+    in.read(magic, sizeof(magic));
+    if (!in || !std::equal(magic, magic + sizeof(magic), MAGIC) || in.get() != VERSION) {
+        throw std::runtime_error("Not a checkpoint: " + filename);
+    }
+
+    CheckpointInfo info;
+    std::vector<std::uint64_t> state;
+    boost::archive::polymorphic_binary_iarchive archive(in, boost::archive::no_header);
+    archive >> info.optimizer >> info.evaluations >> info.step >> state;
+    if (info.optimizer != optimizer.name()) {
+        throw std::runtime_error("Checkpoint " + filename + " holds " + info.optimizer + ", not " + optimizer.name());
+    }
+    optimizer.read(archive);
+    if (!setGeneratorState(state)) {
+        throw std::runtime_error("Damaged generator state in checkpoint: " + filename);
+    }
+    return info;
+}
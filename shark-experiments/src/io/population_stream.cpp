@@ -0,0 +1,298 @@
+/* population_stream.cpp
+ *
+ * DESCRIPTION
+ * Writer and reader for the population snapshot stream, see
+ * io/population_stream.h for the format.
+ */
+#include "io/population_stream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+constexpr char MAGIC[4] = {'P', 'S', 'N', 'P'};
+constexpr unsigned char VERSION = 2;
+constexpr unsigned char KEYFRAME = 'K';
+constexpr unsigned char DELTA = 'D';
+constexpr unsigned int MAX_CONTROL = 80;
+constexpr unsigned int RUN_BASE = 128;
+constexpr unsigned int MAX_RUN = 128;
+
+std::uint64_t bits(double value) {
+    std::uint64_t ret;
+    std::memcpy(&ret, &value, sizeof(ret));
+    return ret;
+}
+
+double real(std::uint64_t value) {
+    double ret;
+    std::memcpy(&ret, &value, sizeof(ret));
+    return ret;
+}
+
+// maps the bits of a double to an unsigned integer of the same order
+std::uint64_t ordered(std::uint64_t bits) { return bits >> 63 ? ~bits : bits | 0x8000000000000000ull; }
+
+std::uint64_t hashRow(std::uint64_t const* row, std::size_t n) {
+    std::uint64_t h = n;
+    for (std::size_t j = 0; j != n; j++) {
+        h = (h ^ row[j]) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 32;
+    }
+    return h;
+}
+
+void putVarint(std::vector<unsigned char>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+bool getVarint(std::istream& in, std::uint64_t& value) {
+    value = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+        int c = in.get();
+        if (c == EOF) return false;
+        value |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+        if ((c & 0x80) == 0) return true;
+    }
+    throw std::runtime_error("Malformed varint in population stream.");
+}
+
+void flushRun(std::vector<unsigned char>& out, unsigned int& run) {
+    while (run > 0) {
+        unsigned int n = std::min(run, MAX_RUN);
+        out.push_back(static_cast<unsigned char>(RUN_BASE + n - 1));
+        run -= n;
+    }
+}
+
+// append the residual of one value, zero residuals are collected in runs
+void putResidual(std::vector<unsigned char>& out, std::uint64_t residual, unsigned int& run) {
+    if (residual == 0) {
+        run++;
+        return;
+    }
+    flushRun(out, run);
+    unsigned int lead = 0;
+    while (lead < 8 && ((residual >> (56 - 8 * lead)) & 0xff) == 0) lead++;
+    unsigned int trail = 0;
+    while (trail < 8 - lead && ((residual >> (8 * trail)) & 0xff) == 0) trail++;
+    out.push_back(static_cast<unsigned char>(lead * 9 + trail));
+    for (unsigned int b = 8 - lead; b-- > trail;) out.push_back(static_cast<unsigned char>(residual >> (8 * b)));
+}
+
+}  // namespace
+
+void PopulationSnapshot::assign(std::uint64_t generation, std::uint64_t evaluations, std::size_t size, std::size_t numberOfVariables, std::size_t numberOfObjectives, double const* points, double const* values) {
+    this->generation = generation;
+    this->evaluations = evaluations;
+    this->size = size;
+    this->numberOfVariables = numberOfVariables;
+    this->numberOfObjectives = numberOfObjectives;
+    this->points.resize(size * numberOfVariables);
+    this->values.resize(size * numberOfObjectives);
+    if (!this->points.empty()) std::memcpy(this->points.data(), points, this->points.size() * sizeof(double));
+    if (!this->values.empty()) std::memcpy(this->values.data(), values, this->values.size() * sizeof(double));
+}
+
+PopulationStreamWriter::PopulationStreamWriter(std::string const& filename, unsigned int keyframeInterval)
+    : m_out(filename, std::ios::binary | std::ios::trunc), m_keyframeInterval(std::max(1u, keyframeInterval)), m_frames(0), m_bytesWritten(0), m_size(0), m_numberOfVariables(0), m_numberOfObjectives(0) {
+    if (!m_out.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+    m_out.write(MAGIC, sizeof(MAGIC));
+    m_out.put(static_cast<char>(VERSION));
+    m_bytesWritten = sizeof(MAGIC) + 1;
+}
+
+PopulationStreamWriter::~PopulationStreamWriter() {
+    close();
+}
+
+void PopulationStreamWriter::write(PopulationSnapshot const& snapshot) {
+    if (!m_out.is_open()) {
+        throw std::runtime_error("Cannot write to stream.");
+    }
+    if (snapshot.points.size() != snapshot.size * snapshot.numberOfVariables || snapshot.values.size() != snapshot.size * snapshot.numberOfObjectives) {
+        throw std::runtime_error("Population snapshot has inconsistent dimensions.");
+    }
+
+    // rows refer to the previous frame, which must have rows of the same shape
+    bool keyframe = m_frames % m_keyframeInterval == 0 || snapshot.numberOfVariables != m_numberOfVariables || snapshot.numberOfObjectives != m_numberOfObjectives;
+    std::size_t n = snapshot.numberOfVariables;
+    std::size_t width = n + snapshot.numberOfObjectives;
+    m_current.resize(snapshot.size * width);
+    for (std::size_t i = 0; i != snapshot.size; i++) {
+        for (std::size_t j = 0; j != n; j++) m_current[i * width + j] = bits(snapshot.points[i * n + j]);
+        for (std::size_t j = n; j != width; j++) m_current[i * width + j] = bits(snapshot.values[i * snapshot.numberOfObjectives + j - n]);
+    }
+    if (keyframe) {
+        m_previous.clear();
+        m_size = 0;
+        m_numberOfVariables = snapshot.numberOfVariables;
+        m_numberOfObjectives = snapshot.numberOfObjectives;
+    }
+    reference(m_current, snapshot.size);
+
+    m_payload.clear();
+    for (std::size_t i = 0; i != snapshot.size; i++) putVarint(m_payload, m_references[i]);
+    unsigned int run = 0;
+    for (std::size_t i = 0; i != snapshot.size; i++) {
+        std::uint64_t const* previous = m_references[i] ? &m_previous[(m_references[i] - 1) * width] : nullptr;
+        for (std::size_t j = 0; j != width; j++) {
+            std::uint64_t current = m_current[i * width + j];
+            putResidual(m_payload, previous ? current ^ previous[j] : current, run);
+        }
+    }
+    flushRun(m_payload, run);
+    m_previous.swap(m_current);
+    m_size = snapshot.size;
+
+    m_frame.clear();
+    m_frame.push_back(keyframe ? KEYFRAME : DELTA);
+    putVarint(m_frame, snapshot.generation);
+    putVarint(m_frame, snapshot.evaluations);
+    putVarint(m_frame, snapshot.size);
+    putVarint(m_frame, snapshot.numberOfVariables);
+    putVarint(m_frame, snapshot.numberOfObjectives);
+    putVarint(m_frame, m_payload.size());
+    m_out.write(reinterpret_cast<char const*>(m_frame.data()), m_frame.size());
+    m_out.write(reinterpret_cast<char const*>(m_payload.data()), m_payload.size());
+    m_bytesWritten += m_frame.size() + m_payload.size();
+    m_frames++;
+}
+
+void PopulationStreamWriter::reference(std::vector<std::uint64_t> const& current, std::size_t size) {
+    std::size_t n = m_numberOfVariables;
+    std::size_t width = n + m_numberOfObjectives;
+    m_references.assign(size, 0);
+    if (m_size == 0) return;
+
+    m_index.clear();
+    m_order.clear();
+    for (std::size_t r = 0; r != m_size; r++) {
+        m_index.emplace(hashRow(&m_previous[r * width], n), r);
+        if (m_numberOfObjectives > 0) m_order.emplace_back(ordered(m_previous[r * width + n]), r);
+    }
+    std::sort(m_order.begin(), m_order.end());
+
+    for (std::size_t i = 0; i != size; i++) {
+        std::uint64_t const* row = &current[i * width];
+        auto match = m_index.find(hashRow(row, n));
+        if (match != m_index.end() && std::equal(row, row + n, &m_previous[match->second * width])) {
+            m_references[i] = match->second + 1;
+        } else if (!m_order.empty()) {
+            // the neighbour in the first objective with the closer value
+            std::uint64_t key = ordered(row[n]);
+            auto next = std::lower_bound(m_order.begin(), m_order.end(), std::make_pair(key, std::size_t(0)));
+            if (next == m_order.end() || (next != m_order.begin() && key - std::prev(next)->first < next->first - key)) --next;
+            m_references[i] = next->second + 1;
+        } else if (i < m_size) {
+            m_references[i] = i + 1;
+        }
+    }
+}
+
+void PopulationStreamWriter::close() {
+    if (m_out.is_open()) m_out.close();
+}
+
+PopulationStreamReader::PopulationStreamReader(std::string const& filename)
+    : m_in(filename, std::ios::binary), m_size(0), m_width(0) {
+    if (!m_in.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+    char magic[sizeof(MAGIC)];
+    m_in.read(magic, sizeof(magic));
+    int version = m_in.get();
+    if (!m_in || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION) {
+        throw std::runtime_error("Not a population stream: " + filename);
+    }
+}
+
+bool PopulationStreamReader::read(PopulationSnapshot& snapshot) {
+    int kind = m_in.get();
+    if (kind == EOF) return false;
+    if (kind != KEYFRAME && kind != DELTA) {
+        throw std::runtime_error("Malformed frame in population stream.");
+    }
+    std::uint64_t size, numberOfVariables, numberOfObjectives, length;
+    if (!getVarint(m_in, snapshot.generation) || !getVarint(m_in, snapshot.evaluations) || !getVarint(m_in, size) || !getVarint(m_in, numberOfVariables) || !getVarint(m_in, numberOfObjectives) || !getVarint(m_in, length)) {
+        throw std::runtime_error("Truncated frame in population stream.");
+    }
+    snapshot.size = size;
+    snapshot.numberOfVariables = numberOfVariables;
+    snapshot.numberOfObjectives = numberOfObjectives;
+    std::size_t width = numberOfVariables + numberOfObjectives;
+    if (kind == KEYFRAME) {
+        m_previous.clear();
+        m_size = 0;
+    } else if (m_width != width) {
+        throw std::runtime_error("Delta frame without matching reference frame.");
+    }
+    m_width = width;
+
+    m_payload.resize(length);
+    m_in.read(reinterpret_cast<char*>(m_payload.data()), length);
+    if (static_cast<std::uint64_t>(m_in.gcount()) != length) {
+        throw std::runtime_error("Truncated frame in population stream.");
+    }
+
+    std::size_t pos = 0;
+    m_references.resize(size);
+    for (std::size_t i = 0; i != size; i++) {
+        std::uint64_t reference = 0;
+        for (unsigned int shift = 0;; shift += 7) {
+            if (pos >= length || shift >= 64) throw std::runtime_error("Truncated payload in population stream.");
+            reference |= static_cast<std::uint64_t>(m_payload[pos] & 0x7f) << shift;
+            if ((m_payload[pos++] & 0x80) == 0) break;
+        }
+        if (reference > m_size) throw std::runtime_error("Malformed row reference in population stream.");
+        m_references[i] = reference;
+    }
+
+    // start from the reference rows, then apply the residuals
+    m_current.resize(size * width);
+    for (std::size_t i = 0; i != size; i++) {
+        for (std::size_t j = 0; j != width; j++) m_current[i * width + j] = m_references[i] ? m_previous[(m_references[i] - 1) * width + j] : 0;
+    }
+    std::size_t total = m_current.size();
+    std::size_t i = 0;
+    while (i < total) {
+        if (pos >= length) throw std::runtime_error("Truncated payload in population stream.");
+        unsigned int control = m_payload[pos++];
+        if (control >= RUN_BASE) {
+            // unchanged values keep the bits of their reference
+            i += control - RUN_BASE + 1;
+            continue;
+        }
+        if (control > MAX_CONTROL) throw std::runtime_error("Malformed payload in population stream.");
+        unsigned int lead = control / 9;
+        unsigned int trail = control % 9;
+        std::uint64_t residual = 0;
+        for (unsigned int b = 8 - lead; b-- > trail;) {
+            if (pos >= length) throw std::runtime_error("Truncated payload in population stream.");
+            residual |= static_cast<std::uint64_t>(m_payload[pos++]) << (8 * b);
+        }
+        m_current[i++] ^= residual;
+    }
+    if (i != total || pos != length) {
+        throw std::runtime_error("Malformed payload in population stream.");
+    }
+    m_previous.swap(m_current);
+    m_size = size;
+
+    snapshot.points.resize(size * numberOfVariables);
+    snapshot.values.resize(size * numberOfObjectives);
+    for (std::size_t r = 0; r != size; r++) {
+        for (std::size_t j = 0; j != numberOfVariables; j++) snapshot.points[r * numberOfVariables + j] = real(m_previous[r * width + j]);
+        for (std::size_t j = numberOfVariables; j != width; j++) snapshot.values[r * numberOfObjectives + j - numberOfVariables] = real(m_previous[r * width + j]);
+    }
+    return true;
+}
@@ -0,0 +1,114 @@
+/* run_cache.cpp
+ *
+ * DESCRIPTION
+ * Keys, hashing and the entry files of RunCache, see io/run_cache.h for
+ * the format. The key is hashed with FNV-1a and the finaliser of
+ * SplitMix64, which spreads similar keys over the whole 64-bit range.
+ */
+#include "io/run_cache.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <boost/archive/polymorphic_binary_iarchive.hpp>
+#include <boost/archive/polymorphic_binary_oarchive.hpp>
+#include <boost/format.hpp>
+#include <boost/serialization/map.hpp>
+#include <boost/serialization/string.hpp>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+// EXPERIMENTS_BUILD_ID, written by cmake/build_id.cmake on every build
+#include "build_id.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char MAGIC[4] = {'R', 'U', 'N', 'C'};
+constexpr unsigned char VERSION = 1;
+
+// version of the results of the cells: bump it with every change to an
+// optimizer, a benchmark or an observation that changes what a cell computes
+constexpr int RESULTS_VERSION = 1;
+
+std::uint64_t hashText(std::string::const_iterator begin, std::string::const_iterator end) {
+    std::uint64_t h = 0xCBF29CE484222325ull;
+    for (; begin != end; ++begin) {
+        h = (h ^ static_cast<unsigned char>(*begin)) * 0x100000001B3ull;
+    }
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+    return h ^ (h >> 31);
+}
+
+}  // namespace
+
+RunKey::RunKey() {
+    add("build", EXPERIMENTS_BUILD_ID).add("results", RESULTS_VERSION);
+    m_configuration = m_text.size();
+}
+
+std::uint64_t RunKey::hash() const { return hashText(m_text.begin(), m_text.end()); }
+
+std::uint64_t RunKey::seed() const { return hashText(m_text.begin() + m_configuration, m_text.end()); }
+
+RunCache::RunCache(std::string directory) : m_directory(std::move(directory)), m_hits(0), m_misses(0) {}
+
+std::string RunCache::filename(RunKey const& key) const {
+    std::string hash = boost::str(boost::format("%016x") % key.hash());
+    return m_directory + "/" + hash.substr(0, 2) + "/" + hash;
+}
+
+bool RunCache::load(RunKey const& key, Outputs& outputs) {
+    std::string name = filename(key);
+    std::ifstream in(name, std::ios::binary);
+    if (!in.is_open()) {
+        m_misses++;
+        return false;
+    }
+    char magic[sizeof(MAGIC)];
+    in.read(magic, sizeof(magic));
+    if (!in || !std::equal(magic, magic + sizeof(magic), MAGIC) || in.get() != VERSION) {
+        throw std::runtime_error("Not a run cache entry: " + name);
+    }
+
+    std::string text;
+    boost::archive::polymorphic_binary_iarchive archive(in, boost::archive::no_header);
+    archive >> text;
+    if (text != key.text()) {
+        m_misses++;
+        return false;
+    }
+    outputs.clear();
+    archive >> outputs;
+    m_hits++;
+    return true;
+}
+
+void RunCache::store(RunKey const& key, Outputs const& outputs) {
+    std::string name = filename(key);
+    fs::create_directories(fs::path(name).parent_path());
+    // one temporary per process, for sweeps that store the same cell at once
+    std::string temporary = name + ".tmp" + std::to_string(::getpid());
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw std::runtime_error("Failed to open file: " + temporary);
+        }
+        out.write(MAGIC, sizeof(MAGIC));
+        out.put(static_cast<char>(VERSION));
+
+        boost::archive::polymorphic_binary_oarchive archive(out, boost::archive::no_header);
+        archive << key.text() << outputs;
+        if (!out) {
+            throw std::runtime_error("Failed to write run cache entry: " + temporary);
+        }
+    }
+    if (std::rename(temporary.c_str(), name.c_str()) != 0) {
+        throw std::runtime_error("Failed to replace run cache entry: " + name);
+    }
+}
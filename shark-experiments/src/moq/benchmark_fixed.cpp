@@ -0,0 +1,26 @@
+/* benchmark_fixed.cpp
+ *
+ * DESCRIPTION
+ * Dimension dispatch for the fixed size benchmarks.
+ */
+#include "moq/benchmark_fixed.h"
+
+std::unique_ptr<MOBenchmark> makeMOBenchmark(std::string const& name, unsigned int dimension, unsigned int instance, double kappa, MOBenchmark::Storage storage,
+                                             MOBenchmark::EigenSolver solver) {
+    switch (dimension) {
+        case 2:
+            return std::unique_ptr<MOBenchmark>(new MOBenchmarkN<2>(name, instance, kappa, storage, solver));
+        case 3:
+            return std::unique_ptr<MOBenchmark>(new MOBenchmarkN<3>(name, instance, kappa, storage, solver));
+        case 5:
+            return std::unique_ptr<MOBenchmark>(new MOBenchmarkN<5>(name, instance, kappa, storage, solver));
+        case 10:
+            return std::unique_ptr<MOBenchmark>(new MOBenchmarkN<10>(name, instance, kappa, storage, solver));
+        case 20:
+            return std::unique_ptr<MOBenchmark>(new MOBenchmarkN<20>(name, instance, kappa, storage, solver));
+        case 40:
+            return std::unique_ptr<MOBenchmark>(new MOBenchmarkN<40>(name, instance, kappa, storage, solver));
+        default:
+            return std::unique_ptr<MOBenchmark>(new MOBenchmark(name, dimension, instance, kappa, storage, solver));
+    }
+}
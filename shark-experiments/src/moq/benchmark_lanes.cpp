@@ -0,0 +1,86 @@
+/* benchmark_lanes.cpp
+ *
+ * DESCRIPTION
+ * Interleaved evaluation of MOBenchmark instances, instantiated for 4, 8
+ * and 16 lanes (one to four AVX2 registers of doubles, or half of that
+ * with AVX-512).
+ */
+#include "moq/benchmark_lanes.h"
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace shark;
+
+namespace {
+
+// squared norm of A^T (x - c) for every lane, accumulated into q
+template <std::size_t Lanes>
+void quadraticForm(std::size_t n, double const* AT, double const* x, double const* c, double* difference, double* q) {
+    for (std::size_t j = 0; j != n; j++) {
+        for (std::size_t l = 0; l != Lanes; l++) difference[j * Lanes + l] = x[j * Lanes + l] - c[j * Lanes + l];
+    }
+    for (std::size_t l = 0; l != Lanes; l++) q[l] = 0.0;
+    for (std::size_t i = 0; i != n; i++) {
+        double d[Lanes] = {};
+        double const* row = AT + i * n * Lanes;
+        for (std::size_t j = 0; j != n; j++) {
+            for (std::size_t l = 0; l != Lanes; l++) d[l] += row[j * Lanes + l] * difference[j * Lanes + l];
+        }
+        for (std::size_t l = 0; l != Lanes; l++) q[l] += d[l] * d[l];
+    }
+}
+
+}  // namespace
+
+template <std::size_t Lanes>
+MOBenchmarkLanes<Lanes>::MOBenchmarkLanes(std::vector<MOBenchmark const*> const& instances) : m_evaluationCounter(0) {
+    if (instances.size() != Lanes) {
+        throw std::runtime_error("MOBenchmarkLanes needs exactly one instance per lane.");
+    }
+    std::size_t n = instances[0]->numberOfVariables();
+    m_dimension = n;
+    m_A1T.resize(n * n * Lanes);
+    m_A2T.resize(n * n * Lanes);
+    m_x1.resize(n * Lanes);
+    m_x2.resize(n * Lanes);
+    m_lower.resize(n * Lanes);
+    m_upper.resize(n * Lanes);
+    m_difference.resize(n * Lanes);
+    for (std::size_t l = 0; l != Lanes; l++) {
+        MOBenchmark const& f = *instances[l];
+        if (f.numberOfVariables() != n) {
+            throw std::runtime_error("MOBenchmarkLanes needs instances of the same dimension.");
+        }
+        for (std::size_t i = 0; i != n; i++) {
+            for (std::size_t j = 0; j != n; j++) {
+                m_A1T[(i * n + j) * Lanes + l] = f.A1()(j, i);
+                m_A2T[(i * n + j) * Lanes + l] = f.A2()(j, i);
+            }
+            m_x1[i * Lanes + l] = f.x1star()(i);
+            m_x2[i * Lanes + l] = f.x2star()(i);
+            m_lower[i * Lanes + l] = f.constraints().lower()(i);
+            m_upper[i * Lanes + l] = f.constraints().upper()(i);
+        }
+        m_a1[l] = f.a1();
+        m_a2[l] = f.a2();
+        m_b1[l] = f.b1();
+        m_b2[l] = f.b2();
+        m_s[l] = f.s();
+    }
+}
+
+template <std::size_t Lanes>
+void MOBenchmarkLanes<Lanes>::eval(double const* points, double* values) const {
+    m_evaluationCounter++;
+    std::size_t n = m_dimension;
+    double q[Lanes];
+    quadraticForm<Lanes>(n, m_A1T.data(), points, m_x1.data(), m_difference.data(), q);
+    for (std::size_t l = 0; l != Lanes; l++) values[l] = 0.5 * m_a1[l] * std::pow(q[l], m_s[l]) + m_b1[l];
+    quadraticForm<Lanes>(n, m_A2T.data(), points, m_x2.data(), m_difference.data(), q);
+    for (std::size_t l = 0; l != Lanes; l++) values[Lanes + l] = 0.5 * m_a2[l] * std::pow(q[l], m_s[l]) + m_b2[l];
+}
+
+template class MOBenchmarkLanes<4>;
+template class MOBenchmarkLanes<8>;
+template class MOBenchmarkLanes<16>;
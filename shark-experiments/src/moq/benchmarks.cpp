@@ -28,13 +28,170 @@
 
 #include "moq/benchmarks.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <stdexcept>
+#include <vector>
 
 using namespace shark;
 using namespace remora;
 using namespace std;
 
+namespace {
+
+// Householder reduction of the symmetric row major n x n matrix M to
+// tridiagonal form T = Q^T M Q with diagonal d and subdiagonal e; the
+// unit reflector vectors of Q = H_0 ... H_{n-3} overwrite the columns of M
+// below the subdiagonal
+void tridiagonalize(vector<double>& M, size_t n, vector<double>& d, vector<double>& e) {
+    d.assign(n, 0.0);
+    e.assign(n, 0.0);
+    vector<double> p(n);
+    for (size_t k = 0; k + 2 < n; k++) {
+        double norm = 0.0;
+        for (size_t i = k + 1; i < n; i++) norm += M[i * n + k] * M[i * n + k];
+        norm = sqrt(norm);
+        double alpha = M[(k + 1) * n + k] > 0 ? -norm : norm;
+        d[k] = M[k * n + k];
+        e[k] = alpha;
+        // v = x - alpha e_1, normalised, stored in column k
+        M[(k + 1) * n + k] -= alpha;
+        double vnorm = 0.0;
+        for (size_t i = k + 1; i < n; i++) vnorm += M[i * n + k] * M[i * n + k];
+        vnorm = sqrt(vnorm);
+        if (vnorm == 0.0) continue;
+        for (size_t i = k + 1; i < n; i++) M[i * n + k] /= vnorm;
+        // A = H A H on the trailing block: p = A v, w = p - (v^T p) v, A -= 2 (v w^T + w v^T)
+        double vp = 0.0;
+        for (size_t i = k + 1; i < n; i++) {
+            double sum = 0.0;
+            for (size_t j = k + 1; j < n; j++) sum += M[i * n + j] * M[j * n + k];
+            p[i] = sum;
+            vp += M[i * n + k] * sum;
+        }
+        for (size_t i = k + 1; i < n; i++) p[i] -= vp * M[i * n + k];
+        for (size_t i = k + 1; i < n; i++) {
+            for (size_t j = k + 1; j < n; j++) M[i * n + j] -= 2.0 * (M[i * n + k] * p[j] + p[i] * M[j * n + k]);
+        }
+    }
+    if (n >= 2) {
+        d[n - 2] = M[(n - 2) * n + n - 2];
+        e[n - 2] = M[(n - 1) * n + n - 2];
+    }
+    if (n >= 1) d[n - 1] = M[(n - 1) * n + n - 1];
+}
+
+// number of eigenvalues of the tridiagonal matrix (d, e) below x (Sturm sequence)
+size_t countBelow(vector<double> const& d, vector<double> const& e, double x) {
+    size_t ret = 0;
+    double q = 1.0;
+    for (size_t i = 0; i < d.size(); i++) {
+        q = d[i] - x - (i ? e[i - 1] * e[i - 1] / q : 0.0);
+        if (q == 0.0) q = -1e-300;
+        if (q < 0.0) ret++;
+    }
+    return ret;
+}
+
+// eigenvalue number index (counted from the largest) of (d, e) by bisection
+double bisect(vector<double> const& d, vector<double> const& e, size_t index) {
+    size_t n = d.size();
+    double lo = d[0], hi = d[0];
+    for (size_t i = 0; i < n; i++) {
+        double radius = (i ? fabs(e[i - 1]) : 0.0) + (i + 1 < n ? fabs(e[i]) : 0.0);
+        lo = min(lo, d[i] - radius);
+        hi = max(hi, d[i] + radius);
+    }
+    // the eigenvalue has n - 1 - index eigenvalues below it
+    size_t below = n - 1 - index;
+    for (int iteration = 0; iteration < 200; iteration++) {
+        double mid = 0.5 * (lo + hi);
+        if (mid <= lo || mid >= hi) break;
+        if (countBelow(d, e, mid) > below)
+            hi = mid;
+        else
+            lo = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+// eigenvector of (d, e) for the eigenvalue lambda by inverse iteration,
+// solving with Gaussian elimination with partial pivoting
+vector<double> inverseIteration(vector<double> const& d, vector<double> const& e, double lambda) {
+    size_t n = d.size();
+    double scale = 0.0;
+    for (size_t i = 0; i < n; i++) scale = max(scale, fabs(d[i]) + (i + 1 < n ? fabs(e[i]) : 0.0));
+    double tiny = max(scale, 1e-300) * numeric_limits<double>::epsilon();
+
+    // factor T - lambda I = P L U, U with two superdiagonals u1, u2
+    vector<double> u0(n), u1(n, 0.0), u2(n, 0.0), l(n, 0.0);
+    vector<char> swapped(n, 0);
+    for (size_t i = 0; i < n; i++) u0[i] = d[i] - lambda;
+    for (size_t i = 0; i + 1 < n; i++) u1[i] = e[i];
+    vector<double> sub(e.begin(), e.end());
+    for (size_t i = 0; i + 1 < n; i++) {
+        if (fabs(sub[i]) > fabs(u0[i])) {
+            // swap rows i and i + 1
+            swapped[i] = 1;
+            double a0 = u0[i], a1 = u1[i], a2 = u2[i];
+            u0[i] = sub[i];
+            u1[i] = u0[i + 1];
+            u2[i] = (i + 2 < n) ? u1[i + 1] : 0.0;
+            double m = a0 / u0[i];
+            l[i] = m;
+            u0[i + 1] = a1 - m * u1[i];
+            u1[i + 1] = (i + 2 < n) ? a2 - m * u2[i] : 0.0;
+        } else {
+            if (u0[i] == 0.0) u0[i] = tiny;
+            double m = sub[i] / u0[i];
+            l[i] = m;
+            u0[i + 1] -= m * u1[i];
+        }
+    }
+    if (u0[n - 1] == 0.0) u0[n - 1] = tiny;
+    for (size_t i = 0; i < n; i++) {
+        if (u0[i] == 0.0) u0[i] = tiny;
+    }
+
+    vector<double> x(n, 1.0);
+    for (int iteration = 0; iteration < 3; iteration++) {
+        // forward substitution with the row interchanges
+        for (size_t i = 0; i + 1 < n; i++) {
+            if (swapped[i]) swap(x[i], x[i + 1]);
+            x[i + 1] -= l[i] * x[i];
+        }
+        // back substitution
+        for (size_t i = n; i-- > 0;) {
+            double sum = x[i];
+            if (i + 1 < n) sum -= u1[i] * x[i + 1];
+            if (i + 2 < n) sum -= u2[i] * x[i + 2];
+            x[i] = sum / u0[i];
+        }
+        double norm = 0.0;
+        for (double v : x) norm += v * v;
+        norm = sqrt(norm);
+        for (double& v : x) v /= norm;
+    }
+    return x;
+}
+
+// eigenvector for eigenvalue number index (counted from the largest) of the symmetric row major matrix M, which is destroyed
+vector<double> symmetricEigenvector(vector<double>& M, size_t n, size_t index) {
+    vector<double> d, e;
+    tridiagonalize(M, n, d, e);
+    vector<double> x = inverseIteration(d, e, bisect(d, e, index));
+    // x = H_0 ... H_{n-3} x
+    for (size_t k = n < 2 ? 0 : n - 2; k-- > 0;) {
+        double dot = 0.0;
+        for (size_t i = k + 1; i < n; i++) dot += M[i * n + k] * x[i];
+        for (size_t i = k + 1; i < n; i++) x[i] -= 2.0 * dot * M[i * n + k];
+    }
+    return x;
+}
+
+}  // namespace
+
 tuple<RealMatrix, RealVector> MOBenchmark::eig(RealMatrix const& U1, RealVector const& D1, RealMatrix const& U2, RealVector const& D2) {
     size_t n = D1.size();
     RealVector invsqrtD2(n);
@@ -50,6 +207,37 @@ tuple<RealMatrix, RealVector> MOBenchmark::eig(RealMatrix const& U1, RealVector
     return make_tuple(V, solver.D());
 }
 
+RealVector MOBenchmark::eigenvector(RealMatrix const& U1, RealVector const& D1, RealMatrix const& U2, RealVector const& D2, unsigned int index) {
+    // H_1 x = lambda H_2 x  <=>  C C^T y = lambda y with C = A_2^{-1} A_1, x = A_2^{-T} y
+    size_t n = D1.size();
+    RealMatrix C = trans(U2) % U1;
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++) C(i, j) *= sqrt(D1(j) / D2(i));
+    RealMatrix CCT = C % trans(C);
+    vector<double> M(n * n);
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++) M[i * n + j] = CCT(i, j);
+    vector<double> y = symmetricEigenvector(M, n, index);
+    RealVector z(n);
+    for (size_t i = 0; i < n; i++) z(i) = y[i] / sqrt(D2(i));
+    return U2 % z;
+}
+
+RealVector MOBenchmark::generalizedEigenvector(unsigned int index) const {
+    if (m_solver == EigenSolver::Single) return eigenvector(m_U1, m_D1, m_U2, m_D2, index);
+    RealMatrix V;
+    RealVector W;
+    tie(V, W) = eig(m_U1, m_D1, m_U2, m_D2);
+    return column(V, index);
+}
+
+RealMatrix MOBenchmark::rotation(RealMatrix const& A, RealVector const& D) {
+    size_t n = D.size();
+    RealVector invsqrtD(n);
+    for (size_t i = 0; i < n; i++) invsqrtD(i) = 1.0 / sqrt(D(i));
+    return A % to_diagonal(invsqrtD);
+}
+
 RealMatrix MOBenchmark::eye(unsigned int n) {
     RealMatrix ret(n, n, 0.0);
     for (unsigned int i = 0; i < n; i++) ret(i, i) = 1;
@@ -136,10 +324,10 @@ RealVector MOBenchmark::createDdup(unsigned int u, unsigned int v) {
     return ret;
 }
 
-MOBenchmark::MOBenchmark(string const& name, unsigned int dimension, unsigned int instance, double kappa)
-    : m_name(name), m_dimension(dimension), m_instance(instance), m_kappa(kappa), m_a1(1), m_b1(0), m_x1(dimension, 0.0), m_U1(dimension, dimension, 0.0), m_D1(dimension, 0.0), m_A1(dimension, dimension, 0.0), m_H1(dimension, dimension, 0.0), m_a2(1), m_b2(0), m_x2(dimension, 0.0), m_U2(dimension, dimension, 0.0), m_D2(dimension, 0.0), m_A2(dimension, dimension, 0.0), m_H2(dimension, dimension, 0.0), m_delta(dimension, 0.0), m_s(1), m_handler(SearchPointType(dimension, -5.0), SearchPointType(dimension, 5.0)), m_rng(instance) {
+MOBenchmark::MOBenchmark(string const& name, unsigned int dimension, unsigned int instance, double kappa, Storage storage, EigenSolver solver)
+    : m_name(name), m_dimension(dimension), m_instance(instance), m_kappa(kappa), m_storage(storage), m_solver(solver), m_a1(1), m_b1(0), m_x1(dimension, 0.0), m_U1(dimension, dimension, 0.0), m_D1(dimension, 0.0), m_A1(dimension, dimension, 0.0), m_H1(storage == Storage::Full ? dimension : 0, storage == Storage::Full ? dimension : 0, 0.0), m_a2(1), m_b2(0), m_x2(dimension, 0.0), m_U2(dimension, dimension, 0.0), m_D2(dimension, 0.0), m_A2(dimension, dimension, 0.0), m_H2(storage == Storage::Full ? dimension : 0, storage == Storage::Full ? dimension : 0, 0.0), m_delta(dimension, 0.0), m_s(1), m_handler(SearchPointType(dimension, -5.0), SearchPointType(dimension, 5.0)), m_rng(instance) {
     announceConstraintHandler(&m_handler);
-    m_features |= CAN_PROPOSE_STARTING_POINT;
+    m_features |= CAN_PROPOSE_STARTING_POINT | IS_THREAD_SAFE;
 
     if (name.size() != 3) throw runtime_error("invalid problem name: " + name);
     unsigned int category = name[0] - '0';
@@ -273,11 +461,8 @@ MOBenchmark::MOBenchmark(string const& name, unsigned int dimension, unsigned in
         m_D1 = createD();
         m_D2 = createD();
         if (aligned) {
-            RealMatrix V;
-            RealVector W;
-            tie(V, W) = eig(m_U1, m_D1, m_U2, m_D2);
             unsigned int i = uniDim(m_rng);
-            RealVector delta = column(V, i);
+            RealVector delta = generalizedEigenvector(i);
             delta /= norm_2(delta);
             RealMatrix UT = sampleUTdelta(delta);
             m_U1 = UT % m_U1;
@@ -290,15 +475,14 @@ MOBenchmark::MOBenchmark(string const& name, unsigned int dimension, unsigned in
 
     m_A1 = m_U1 % to_diagonal(sqrt(m_D1));
     m_A2 = m_U2 % to_diagonal(sqrt(m_D2));
-    m_H1 = m_A1 % trans(m_A1);
-    m_H2 = m_A2 % trans(m_A2);
+    if (m_storage == Storage::Full) {
+        m_H1 = m_A1 % trans(m_A1);
+        m_H2 = m_A2 % trans(m_A2);
+    }
 
     if (deltaFromGEV) {
-        RealMatrix V;
-        RealVector W;
-        tie(V, W) = eig(m_U1, m_D1, m_U2, m_D2);
         unsigned int i = uniDim(m_rng);
-        m_delta = column(V, i);
+        m_delta = generalizedEigenvector(i);
         m_delta /= norm_2(m_delta);
     }
 
@@ -312,4 +496,10 @@ MOBenchmark::MOBenchmark(string const& name, unsigned int dimension, unsigned in
     m_a2 = pow(10.0, 6 * uni(m_rng));
     m_b1 = 2 * m_a1 * uni(m_rng) - m_a1;
     m_b2 = 2 * m_a2 * uni(m_rng) - m_a2;
+
+    // U_i is rebuilt from A_i on demand, see U1()
+    if (m_storage == Storage::Compact) {
+        RealMatrix().swap(m_U1);
+        RealMatrix().swap(m_U2);
+    }
 }
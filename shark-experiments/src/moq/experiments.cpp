@@ -32,14 +32,26 @@
 #include <shark/Algorithms/DirectSearch/SMS-EMOA.h>
 #include <shark/Core/Random.h>
 
+#include <algorithm>
 #include <cstdio>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
+#include "algorithms/front_sorting_nsga2.h"
+#include "algorithms/lockstep_mocma.h"
+#include "algorithms/parallel_mocma.h"
+#include "io/run_cache.h"
+#include "moq/benchmark_fixed.h"
+#include "moq/benchmark_lanes.h"
 #include "moq/benchmarks.h"
+#include "parallel/prefetcher.h"
 
 using namespace shark;
 using namespace remora;
@@ -62,12 +74,125 @@ double hypervolume(Solution const& solution, RealVector const& reference) {
     return hv(front, reference);
 }
 
+double hypervolume(std::vector<RealVector> const& values, RealVector const& reference) {
+    HypervolumeCalculator hv;
+    std::vector<RealVector> front;
+    for (auto const& v : values) {
+        if (v(0) < reference(0) && v(1) < reference(1)) front.push_back(v);
+    }
+    return hv(front, reference);
+}
+
+// base seed of the cached cells, which derive their own seeds from it
+constexpr std::uint64_t SEED = 42;  // (the answer)
+
+// key of one cell: the hypervolume over time of one run on one instance
+RunKey cellKey(string const& name, int dim, int instance, string const& optimizer, int mu, double sigma, int budget) {
+    RunKey key;
+    key.add("experiment", "moq").add("function", name).add("dimension", dim).add("instance", instance);
+    key.add("optimizer", optimizer).add("mu", mu);
+    if (sigma > 0) key.add("sigma", sigma);
+    key.add("budget", budget).add("seed", SEED).add("observation", "normalized hypervolume at every 1% of the budget");
+    return key;
+}
+
+RunCache::Outputs hypervolumes(double const* values) { return RunCache::Outputs{{"hypervolume", std::string(reinterpret_cast<char const*>(values), 100 * sizeof(double))}}; }
+
+bool loadHypervolumes(RunCache& cache, RunKey const& key, double* values) {
+    RunCache::Outputs outputs;
+    if (!cache.load(key, outputs)) return false;
+    std::string const& bytes = outputs["hypervolume"];
+    if (bytes.size() != 100 * sizeof(double)) {
+        throw std::runtime_error("Damaged run cache entry for:\n" + key.text());
+    }
+    std::memcpy(values, bytes.data(), bytes.size());
+    return true;
+}
+
+// instances built ahead of the one being optimised, and threads building them
+constexpr std::size_t PREFETCH = 4;
+constexpr std::size_t PREFETCH_THREADS = 2;
+
+// MO-CMA-ES column of the results for all instances of one problem, LANES
+// instances at a time (the last batch repeats its last instance); with a
+// cache, a batch is only run if one of its instances is not cached, and it
+// is seeded from its key
+constexpr int LANES = 8;
+void lockstepMOCMA(string const& name, int problem, int align, int shape, int dim, int mu, int budget, RunCache* cache) {
+    for (int first = 0; first < RUNS; first += LANES) {
+        // the lanes of a batch share one generator, so the batch is part of the key
+        std::vector<RunKey> keys;
+        bool cached = cache != nullptr;
+        for (int l = 0; l < LANES && first + l < RUNS; l++) {
+            keys.push_back(cellKey(name, dim, first + l, "LockstepMOCMA", mu, 3.0, budget));
+            keys.back().add("lanes", LANES).add("batch", first);
+            if (cache) cached = loadHypervolumes(*cache, keys.back(), result[problem][align][shape][first + l][0]) && cached;
+        }
+        if (cached) continue;
+        if (cache) random::globalRng().seed(keys[0].seed());
+
+        std::vector<std::unique_ptr<MOBenchmark>> instances;
+        std::vector<MOBenchmark const*> lanes;
+        for (int l = 0; l < LANES; l++) {
+            instances.push_back(makeMOBenchmark(name, dim, std::min(first + l, RUNS - 1)));
+            lanes.push_back(instances.back().get());
+        }
+        MOBenchmarkLanes<LANES> f(lanes);
+        LockstepMOCMA<LANES> mocma;
+        mocma.initialSigma() = 3.0;
+        mocma.mu() = mu;
+        mocma.init(f);
+
+        std::vector<RealVector> points, values;
+        for (int t = 0; t < 100; t++) {
+            // every evaluation of f is one evaluation per instance
+            while (f.evaluationCounter() < static_cast<std::size_t>(budget * (t + 1) / 100)) mocma.step(f);
+            for (int l = 0; l < LANES && first + l < RUNS; l++) {
+                RealVector utopian = instances[l]->utopian();
+                RealVector nadir = instances[l]->nadir();
+                double refvol = (nadir(0) - utopian(0)) * (nadir(1) - utopian(1));
+                mocma.solution(l, points, values);
+                result[problem][align][shape][first + l][0][t] = hypervolume(values, nadir) / refvol;
+            }
+        }
+        if (cache) {
+            for (int l = 0; l < LANES && first + l < RUNS; l++) cache->store(keys[l], hypervolumes(result[problem][align][shape][first + l][0]));
+        }
+    }
+}
+
 int main(int argc, char** argv) {
     auto dim = 10;
     auto mu = 20;
     auto budget = 100000;
+    // "lockstep": run the MO-CMA-ES column with LockstepMOCMA, several
+    // instances per core at once, instead of Shark's MOCMA; the results go
+    // to "results-lockstep"
+    // "cache": seed every run from its configuration and reuse the results
+    // of runs with the same configuration from the run cache
+    // "frontsort": run the NSGA-II column with FrontSortingNSGAII, which
+    // takes the same steps as Shark's RealCodedNSGAII
+    // "parallel": run the MO-CMA-ES column with ParallelMOCMA on the calling
+    // thread, whose population lives in contiguous matrices and which does
+    // not allocate in steady state; it draws other random numbers than
+    // Shark's MOCMA, so the results go to "results-parallel"
+    bool lockstep = false;
+    bool useCache = false;
+    bool frontSorting = false;
+    bool parallelMOCMA = false;
+    for (int i = 1; i < argc; i++) {
+        lockstep = lockstep || string(argv[i]) == "lockstep";
+        useCache = useCache || string(argv[i]) == "cache";
+        frontSorting = frontSorting || string(argv[i]) == "frontsort";
+        parallelMOCMA = parallelMOCMA || string(argv[i]) == "parallel";
+    }
+    if (lockstep && parallelMOCMA) {
+        throw std::runtime_error("lockstep cannot be combined with parallel.");
+    }
+    std::unique_ptr<RunCache> cache;
+    if (useCache) cache.reset(new RunCache("run-cache"));
 
-    random::globalRng().seed(42);  // (the answer)
+    random::globalRng().seed(SEED);
     cout << setprecision(20);
 
     // instantiate solvers
@@ -78,11 +203,58 @@ int main(int argc, char** argv) {
     smsemoa.mu() = mu;
     RealCodedNSGAII nsga2;
     nsga2.mu() = mu;
+    FrontSortingNSGAII<RealCodedNSGAII> frontSortingNsga2;
+    frontSortingNsga2.mu() = mu;
+    ParallelMOCMA parallelMocma;
+    parallelMocma.initialSigma() = 3.0;
+    parallelMocma.mu() = mu;
     std::vector<AbstractMultiObjectiveOptimizer<RealVector>*> algos{&mocma, &smsemoa, &nsga2};
+    if (parallelMOCMA) algos[0] = &parallelMocma;
+    if (frontSorting) algos[2] = &frontSortingNsga2;
+    std::vector<double> sigmas{3.0, 0.0, 0.0};
 
     string problemchar = "123456789";
     string alignchar = "|/";
     string shapechar = "CIJ";
+
+    // cells in loop order; the results of cached runs are loaded up front,
+    // and only cells with a run left to do need their instance
+    constexpr std::size_t CELLS = 9 * 2 * 3 * RUNS;
+    std::vector<char> cached(CELLS * 3, 0);
+    std::vector<std::size_t> jobs;
+    for (std::size_t cell = 0; cell != CELLS; cell++) {
+        int instance = cell % RUNS;
+        int shape = cell / RUNS % 3;
+        int align = cell / RUNS / 3 % 2;
+        int problem = cell / RUNS / 3 / 2;
+        string name{problemchar[problem], alignchar[align], shapechar[shape]};
+        bool needed = false;
+        for (int algo = 0; algo < 3; algo++) {
+            // the lockstep batches build their own instances
+            if (lockstep && algo == 0) continue;
+            if (cache) {
+                RunKey key = cellKey(name, dim, instance, algos[algo]->name(), mu, sigmas[algo], budget);
+                cached[cell * 3 + algo] = loadHypervolumes(*cache, key, result[problem][align][shape][instance][algo]);
+            }
+            needed = needed || !cached[cell * 3 + algo];
+        }
+        if (needed) jobs.push_back(cell);
+    }
+
+    // the instances of these cells in loop order, constructed in the background
+    Prefetcher<MOBenchmark> instances(
+        jobs.size(),
+        [&](std::size_t i) {
+            std::size_t job = jobs[i];
+            int instance = job % RUNS;
+            int shape = job / RUNS % 3;
+            int align = job / RUNS / 3 % 2;
+            int problem = job / RUNS / 3 / 2;
+            string name{problemchar[problem], alignchar[align], shapechar[shape]};
+            return makeMOBenchmark(name, dim, instance);
+        },
+        PREFETCH, PREFETCH_THREADS);
+
     for (int problem = 0; problem < 9; problem++) {
         for (int align = 0; align < 2; align++) {
             for (int shape = 0; shape < 3; shape++) {
@@ -90,11 +262,21 @@ int main(int argc, char** argv) {
                 name += problemchar[problem];
                 name += alignchar[align];
                 name += shapechar[shape];
+                if (lockstep) lockstepMOCMA(name, problem, align, shape, dim, mu, budget, cache.get());
 
                 for (int instance = 0; instance < RUNS; instance++) {
-                    // problem and reference point
                     cout << name << " " << instance << endl;
-                    MOBenchmark f(name, dim, instance);
+                    std::size_t cell = ((problem * 2 + align) * 3 + shape) * RUNS + instance;
+                    if (!std::binary_search(jobs.begin(), jobs.end(), cell)) {
+                        for (int algo = 0; algo < 3; algo++) {
+                            cout << "  [" << algo << "]: " << result[problem][align][shape][instance][algo][99] << (lockstep && algo == 0 ? " (lockstep)" : " (cached)") << endl;
+                        }
+                        continue;
+                    }
+
+                    // problem and reference point
+                    std::unique_ptr<MOBenchmark> function = instances.next();
+                    MOBenchmark& f = *function;
                     RealVector utopian = f.utopian();
                     RealVector nadir = f.nadir();
                     RealVector ref = nadir;
@@ -106,23 +288,42 @@ int main(int argc, char** argv) {
 
                     // run all algorithms
                     for (int algo = 0; algo < 3; algo++) {
+                        if (lockstep && algo == 0) {
+                            cout << "  [" << algo << "]: " << result[problem][align][shape][instance][algo][99] << " (lockstep)" << endl;
+                            continue;
+                        }
                         auto& a = *algos[algo];
+                        double* hvs = result[problem][align][shape][instance][algo];
+                        if (cached[cell * 3 + algo]) {
+                            cout << "  [" << algo << "]: " << hvs[99] << " (cached)" << endl;
+                            continue;
+                        }
+                        RunKey key = cellKey(name, dim, instance, a.name(), mu, sigmas[algo], budget);
+                        if (cache) random::globalRng().seed(key.seed());
                         f.init();
                         a.init(f);
                         for (int t = 0; t < 100; t++) {
                             while (f.evaluationCounter() < budget * (t + 1) / 100) a.step(f);
                             double hv = hypervolume(a.solution(), nadir);
-                            result[problem][align][shape][instance][algo][t] = hv / refvol;
+                            hvs[t] = hv / refvol;
                         }
-                        cout << "  [" << algo << "]: " << result[problem][align][shape][instance][algo][99] << endl;
+                        if (cache) cache->store(key, hypervolumes(hvs));
+                        cout << "  [" << algo << "]: " << hvs[99] << endl;
                     }
                 }
             }
         }
     }
 
+    cout << "waited for " << instances.waits() << " instances" << endl;
+    if (cache) cout << "run cache: " << cache->hits() << " hits, " << cache->misses() << " misses" << endl;
+
     // store the results for later processing
-    FILE* file = fopen("results", "wb+");
+    // with another MO-CMA-ES column, to a file of their own
+    string resultsName = "results";
+    if (lockstep) resultsName += "-lockstep";
+    if (parallelMOCMA) resultsName += "-parallel";
+    FILE* file = fopen(resultsName.c_str(), "wb+");
     fwrite(result, sizeof(double), sizeof(result) / sizeof(double), file);
     fclose(file);
 }
@@ -0,0 +1,148 @@
+/* islands.cpp
+ *
+ * DESCRIPTION
+ * Island model against a single population on one MOBenchmark problem, at
+ * equal total evaluations. For every instance the single population runs
+ * the budget on one thread, then the IslandModel splits the same budget
+ * over its islands. Printed are the normalised hypervolume (reference
+ * point: the nadir) of the single population and of the merged
+ * non-dominated solutions of the islands, the wall times, the evaluations
+ * actually charged to the benchmark (islands overshoot by at most one
+ * step each) and the number of individuals that migrated. A shared
+ * ParetoArchive2D collects the solutions of all islands over the run; its
+ * hypervolume is printed as well.
+ *
+ * Usage: experiment_islands [mocma|smsemoa|nsga2] [islands]
+ *                           [ring|full|random] [interval] [migrants]
+ *                           [problem] [dim] [evaluations] [instances]
+ */
+#include <shark/Algorithms/DirectSearch/MOCMA.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculator.h>
+#include <shark/Algorithms/DirectSearch/RealCodedNSGAII.h>
+#include <shark/Algorithms/DirectSearch/SMS-EMOA.h>
+#include <shark/Core/Random.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "algorithms/island_model.h"
+#include "moq/benchmarks.h"
+#include "parallel/pareto_archive.h"
+
+using namespace shark;
+
+template <typename Solution>
+double normalizedHypervolume(MOBenchmark const &benchmark, Solution const &solution) {
+    RealVector utopian = benchmark.utopian();
+    RealVector nadir = benchmark.nadir();
+    std::vector<RealVector> front;
+    for (auto const &s : solution) {
+        if (s.value(0) < nadir(0) && s.value(1) < nadir(1)) front.push_back(s.value);
+    }
+    HypervolumeCalculator hv;
+    return hv(front, nadir) / ((nadir(0) - utopian(0)) * (nadir(1) - utopian(1)));
+}
+
+double normalizedHypervolume(MOBenchmark const &benchmark, ParetoArchive2D::Snapshot const &snapshot) {
+    std::vector<ParetoArchive2D::Solution> solution;
+    for (std::size_t i = 0; i != snapshot.size(); i++) solution.push_back(snapshot[i]);
+    return normalizedHypervolume(benchmark, solution);
+}
+
+// the settings of experiment_moq
+template <typename Optimizer>
+void configure(Optimizer &optimizer) {
+    optimizer.mu() = 20;
+}
+void configure(MOCMA &optimizer) {
+    optimizer.mu() = 20;
+    optimizer.initialSigma() = 3.0;
+}
+
+template <typename Optimizer>
+void compare(typename IslandModel<Optimizer>::Topology topology, std::size_t islands, std::size_t interval, std::size_t migrants, std::string const &problem, unsigned int dim,
+             std::size_t budget, std::size_t instances) {
+    double hvSingle = 0.0, hvIslands = 0.0, timeSingle = 0.0, timeIslands = 0.0;
+    std::cout << std::fixed << std::setprecision(4);
+    for (std::size_t instance = 0; instance != instances; instance++) {
+        MOBenchmark benchmark(problem, dim, instance);
+        random::globalRng().seed(instance + 1);
+
+        Optimizer single;
+        configure(single);
+        benchmark.init();
+        auto start = std::chrono::steady_clock::now();
+        single.init(benchmark);
+        while (benchmark.evaluationCounter() < budget) single.step(benchmark);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        double hv = normalizedHypervolume(benchmark, single.solution());
+        hvSingle += hv;
+        timeSingle += elapsed.count();
+        std::cout << problem << " " << instance << "  single  hv " << hv << "  " << std::setw(8) << elapsed.count() << " s  " << benchmark.evaluationCounter() << " evals" << std::endl;
+
+        IslandModel<Optimizer> model(islands, [](Optimizer &optimizer) { configure(optimizer); });
+        model.topology() = topology;
+        model.interval() = interval;
+        model.migrants() = migrants;
+        ParetoArchive2D archive;
+        model.setArchive(&archive);
+        benchmark.init();
+        start = std::chrono::steady_clock::now();
+        model.run(benchmark, budget);
+        elapsed = std::chrono::steady_clock::now() - start;
+        hv = normalizedHypervolume(benchmark, model.solution());
+        hvIslands += hv;
+        timeIslands += elapsed.count();
+        std::cout << problem << " " << instance << "  islands hv " << hv << "  " << std::setw(8) << elapsed.count() << " s  " << benchmark.evaluationCounter() << " evals  "
+                  << model.sent() << " sent " << model.received() << " received" << std::endl;
+        std::cout << problem << " " << instance << "  archive hv " << normalizedHypervolume(benchmark, archive.snapshot()) << "  " << archive.size() << " solutions" << std::endl;
+    }
+    std::cout << "mean  single  hv " << hvSingle / instances << "  " << timeSingle / instances << " s" << std::endl;
+    std::cout << "mean  islands hv " << hvIslands / instances << "  " << timeIslands / instances << " s" << std::endl;
+}
+
+template <typename Optimizer>
+void compare(std::string const &topology, std::size_t islands, std::size_t interval, std::size_t migrants, std::string const &problem, unsigned int dim, std::size_t budget,
+             std::size_t instances) {
+    typedef typename IslandModel<Optimizer>::Topology Topology;
+    Topology t;
+    if (topology == "ring") {
+        t = Topology::Ring;
+    } else if (topology == "full") {
+        t = Topology::FullyConnected;
+    } else if (topology == "random") {
+        t = Topology::Random;
+    } else {
+        throw std::runtime_error("unknown topology: " + topology);
+    }
+    compare<Optimizer>(t, islands, interval, migrants, problem, dim, budget, instances);
+}
+
+int main(int argc, char *argv[]) {
+    std::string algorithm = argc > 1 ? argv[1] : "mocma";
+    std::size_t islands = argc > 2 ? std::atoi(argv[2]) : 4;
+    std::string topology = argc > 3 ? argv[3] : "ring";
+    std::size_t interval = argc > 4 ? std::atoi(argv[4]) : 10;
+    std::size_t migrants = argc > 5 ? std::atoi(argv[5]) : 4;
+    std::string problem = argc > 6 ? argv[6] : "1/C";
+    unsigned int dim = argc > 7 ? std::atoi(argv[7]) : 10;
+    std::size_t budget = argc > 8 ? std::atoi(argv[8]) : 100000;
+    std::size_t instances = argc > 9 ? std::atoi(argv[9]) : 5;
+
+    std::cout << algorithm << " " << islands << " islands, " << topology << " topology, " << migrants << " migrants every " << interval << " generations, " << problem
+              << " dim=" << dim << " evaluations=" << budget << std::endl;
+    if (algorithm == "mocma") {
+        compare<MOCMA>(topology, islands, interval, migrants, problem, dim, budget, instances);
+    } else if (algorithm == "smsemoa") {
+        compare<SMSEMOA>(topology, islands, interval, migrants, problem, dim, budget, instances);
+    } else if (algorithm == "nsga2") {
+        compare<RealCodedNSGAII>(topology, islands, interval, migrants, problem, dim, budget, instances);
+    } else {
+        throw std::runtime_error("unknown algorithm: " + algorithm);
+    }
+}
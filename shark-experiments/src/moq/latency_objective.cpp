@@ -0,0 +1,57 @@
+/* latency_objective.cpp
+ *
+ * DESCRIPTION
+ * Delay sampling and waiting of LatencyObjective.
+ */
+#include "moq/latency_objective.h"
+
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+#include "algorithms/philox.h"
+
+using namespace shark;
+
+LatencyObjective::LatencyObjective(MultiObjectiveFunction const& function, Latency const& latency) : m_function(function), m_latency(latency), m_calls(0) {
+    if (!(latency.median >= 0.0)) throw std::runtime_error("LatencyObjective: the median delay must be non-negative.");
+    if (latency.distribution == Distribution::Pareto && !(latency.shape > 0.0)) throw std::runtime_error("LatencyObjective: the Pareto tail index must be positive.");
+    if (function.hasConstraintHandler()) announceConstraintHandler(&function.getConstraintHandler());
+    if (function.canProposeStartingPoint()) m_features |= CAN_PROPOSE_STARTING_POINT;
+    if (function.isThreadSafe()) m_features |= IS_THREAD_SAFE;
+}
+
+double LatencyObjective::delay(std::uint64_t index) const {
+    std::uint32_t words[4];
+    Philox::block(m_latency.seed, index, 0, words);
+    // uniform in (0, 1] from 53 bits
+    double u1 = ((((static_cast<std::uint64_t>(words[0]) << 32) | words[1]) >> 11) + 1) * 0x1p-53;
+    double u2 = ((((static_cast<std::uint64_t>(words[2]) << 32) | words[3]) >> 11) + 1) * 0x1p-53;
+    switch (m_latency.distribution) {
+        case Distribution::Constant:
+            return m_latency.median;
+        case Distribution::LogNormal:
+            return m_latency.median * std::exp(m_latency.shape * std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * M_PI * u2));
+        case Distribution::Pareto:
+            return m_latency.median * std::pow(2.0 * u1, -1.0 / m_latency.shape);
+    }
+    return m_latency.median;
+}
+
+LatencyObjective::ResultType LatencyObjective::eval(SearchPointType const& x) const {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    ResultType ret = m_function.eval(x);
+    incrementShared(m_evaluationCounter);
+    std::chrono::duration<double> seconds(delay(m_calls.fetch_add(1, std::memory_order_relaxed)));
+    Clock::time_point end = start + std::chrono::duration_cast<Clock::duration>(seconds);
+    if (m_latency.wait == Wait::Sleep) {
+        std::this_thread::sleep_until(end);
+    } else {
+        while (Clock::now() < end) {
+        }
+    }
+    m_injected.increment(std::chrono::duration_cast<std::chrono::nanoseconds>(seconds).count());
+    return ret;
+}
@@ -0,0 +1,312 @@
+/* structured_benchmark.cpp
+ *
+ * DESCRIPTION
+ * Implicit rotations and the construction of the structured benchmark
+ * instances. The category logic follows MOBenchmark::MOBenchmark().
+ */
+#include "moq/structured_benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+using namespace shark;
+using namespace std;
+
+void ImplicitRotation::sampleBlocks(size_t blockSize, mt19937& rng, size_t fix) {
+    if (blockSize == 0) throw runtime_error("ImplicitRotation needs a positive block size.");
+    m_permutation.clear();
+    for (size_t i = 0; i < m_dimension; i++) {
+        if (i != fix) m_permutation.push_back(i);
+    }
+    shuffle(m_permutation.begin(), m_permutation.end(), rng);
+    if (fix < m_dimension) m_permutation.push_back(fix);
+
+    size_t free = fix < m_dimension ? m_dimension - 1 : m_dimension;
+    m_blockStart.assign(1, 0);
+    m_blockOffset.clear();
+    m_blocks.clear();
+    normal_distribution<double> normal;
+    while (m_blockStart.back() != m_dimension) {
+        size_t start = m_blockStart.back();
+        size_t m = start < free ? min(blockSize, free - start) : 1;
+        m_blockOffset.push_back(m_blocks.size());
+        m_blockStart.push_back(start + m);
+        m_blocks.resize(m_blocks.size() + m * m);
+        double* Q = m_blocks.data() + m_blockOffset.back();
+        if (start >= free) {
+            Q[0] = 1.0;
+            continue;
+        }
+        // Gram-Schmidt on the columns of a Gaussian matrix, as MOBenchmark::sampleU()
+        for (size_t e = 0; e < m * m; e++) Q[e] = normal(rng);
+        for (size_t c = 0; c < m; c++) {
+            for (size_t d = 0; d < c; d++) {
+                double dot = 0.0;
+                for (size_t r = 0; r < m; r++) dot += Q[r * m + c] * Q[r * m + d];
+                for (size_t r = 0; r < m; r++) Q[r * m + c] -= dot * Q[r * m + d];
+            }
+            double norm = 0.0;
+            for (size_t r = 0; r < m; r++) norm += Q[r * m + c] * Q[r * m + c];
+            norm = sqrt(norm);
+            for (size_t r = 0; r < m; r++) Q[r * m + c] /= norm;
+        }
+    }
+}
+
+void ImplicitRotation::sampleReflectors(size_t k, mt19937& rng, size_t fix) {
+    normal_distribution<double> normal;
+    for (size_t r = 0; r < k; r++) {
+        size_t offset = m_reflectors.size();
+        m_reflectors.resize(offset + m_dimension);
+        double* v = m_reflectors.data() + offset;
+        double norm = 0.0;
+        for (size_t i = 0; i < m_dimension; i++) {
+            v[i] = normal(rng);
+            if (i == fix) v[i] = 0.0;
+            norm += v[i] * v[i];
+        }
+        norm = sqrt(norm);
+        for (size_t i = 0; i < m_dimension; i++) v[i] /= norm;
+    }
+}
+
+void ImplicitRotation::alignColumn(size_t p, vector<double> const& target) {
+    // U H e_p = target for H = I - 2 v v^T, v proportional to e_p - U^T target
+    vector<double> v(m_dimension);
+    applyTranspose(target.data(), v.data());
+    for (double& e : v) e = -e;
+    v[p] += 1.0;
+    double norm = sqrt(inner_product(v.begin(), v.end(), v.begin(), 0.0));
+    if (norm < 1e-12) return;
+    for (double& e : v) e /= norm;
+    m_reflectors.insert(m_reflectors.end(), v.begin(), v.end());
+}
+
+void ImplicitRotation::reflect(size_t r, double* y) const {
+    double const* v = m_reflectors.data() + r * m_dimension;
+    double dot = 0.0;
+    for (size_t i = 0; i < m_dimension; i++) dot += v[i] * y[i];
+    dot *= 2.0;
+    for (size_t i = 0; i < m_dimension; i++) y[i] -= dot * v[i];
+}
+
+void ImplicitRotation::apply(double const* x, double* out) const {
+    vector<double> y(x, x + m_dimension);
+    for (size_t r = numberOfReflectors(); r-- > 0;) reflect(r, y.data());
+    if (m_blockStart.empty()) {
+        copy(y.begin(), y.end(), out);
+        return;
+    }
+    for (size_t j = 0; j + 1 < m_blockStart.size(); j++) {
+        size_t const* index = m_permutation.data() + m_blockStart[j];
+        size_t m = m_blockStart[j + 1] - m_blockStart[j];
+        double const* Q = m_blocks.data() + m_blockOffset[j];
+        for (size_t r = 0; r < m; r++) {
+            double sum = 0.0;
+            for (size_t c = 0; c < m; c++) sum += Q[r * m + c] * y[index[c]];
+            out[index[r]] = sum;
+        }
+    }
+}
+
+void ImplicitRotation::applyTranspose(double const* x, double* out) const {
+    if (m_blockStart.empty()) {
+        copy(x, x + m_dimension, out);
+    } else {
+        for (size_t j = 0; j + 1 < m_blockStart.size(); j++) {
+            size_t const* index = m_permutation.data() + m_blockStart[j];
+            size_t m = m_blockStart[j + 1] - m_blockStart[j];
+            double const* Q = m_blocks.data() + m_blockOffset[j];
+            for (size_t c = 0; c < m; c++) out[index[c]] = 0.0;
+            for (size_t r = 0; r < m; r++) {
+                double xr = x[index[r]];
+                for (size_t c = 0; c < m; c++) out[index[c]] += Q[r * m + c] * xr;
+            }
+        }
+    }
+    for (size_t r = 0; r < numberOfReflectors(); r++) reflect(r, out);
+}
+
+double StructuredMOBenchmark::quadraticForm(ImplicitRotation const& U, RealVector const& D, double const* y, double* buffer) {
+    U.applyTranspose(y, buffer);
+    double ret = 0.0;
+    for (size_t i = 0; i < D.size(); i++) ret += D(i) * buffer[i] * buffer[i];
+    return ret;
+}
+
+StructuredMOBenchmark::ResultType StructuredMOBenchmark::eval(SearchPointType const& x) const {
+    incrementShared(m_evaluationCounter);
+    vector<double> y(m_dimension), buffer(m_dimension);
+    for (size_t i = 0; i < m_dimension; i++) y[i] = x(i) - m_x1(i);
+    double q1 = quadraticForm(m_U1, m_D1, y.data(), buffer.data());
+    for (size_t i = 0; i < m_dimension; i++) y[i] = x(i) - m_x2(i);
+    double q2 = quadraticForm(m_U2, m_D2, y.data(), buffer.data());
+    return RealVector{0.5 * m_a1 * pow(q1, m_s) + m_b1, 0.5 * m_a2 * pow(q2, m_s) + m_b2};
+}
+
+RealVector StructuredMOBenchmark::nadir() const {
+    vector<double> buffer(m_dimension);
+    double q1 = quadraticForm(m_U1, m_D1, m_delta.data(), buffer.data());
+    double q2 = quadraticForm(m_U2, m_D2, m_delta.data(), buffer.data());
+    return RealVector{0.5 * m_a1 * pow(q1, m_s) + m_b1, 0.5 * m_a2 * pow(q2, m_s) + m_b2};
+}
+
+ImplicitRotation StructuredMOBenchmark::sampleRotation(size_t fix) {
+    ImplicitRotation ret(m_dimension);
+    if (m_structure == Structure::BlockDiagonal)
+        ret.sampleBlocks(m_size, m_rng, fix);
+    else
+        ret.sampleReflectors(m_size, m_rng, fix);
+    return ret;
+}
+
+vector<double> StructuredMOBenchmark::gauss(unsigned int n) {
+    vector<double> ret(n);
+    normal_distribution<double> normal;
+    for (unsigned int i = 0; i < n; i++) ret[i] = normal(m_rng);
+    return ret;
+}
+
+RealVector StructuredMOBenchmark::createD() {
+    RealVector ret(m_dimension);
+    for (unsigned int i = 0; i < m_dimension; i++) ret(i) = pow(m_kappa, i / (m_dimension - 1.0));
+    shuffle(ret.begin(), ret.end(), m_rng);
+    return ret;
+}
+
+RealVector StructuredMOBenchmark::createDdup(unsigned int u, unsigned int v) {
+    if (v < u) swap(u, v);
+    unsigned int z = m_dimension - 1;
+    RealVector ret(m_dimension);
+    for (unsigned int i = 0; i < z; i++) ret(i) = pow(m_kappa, i / (z - 1.0));
+    shuffle(ret.begin(), ret.begin() + z, m_rng);
+    ret(z) = ret[u];
+    if (v != z) swap(ret(v), ret(z));
+    return ret;
+}
+
+StructuredMOBenchmark::StructuredMOBenchmark(string const& name, unsigned int dimension, unsigned int instance, Structure structure, unsigned int size, double kappa)
+    : m_name(name), m_dimension(dimension), m_instance(instance), m_structure(structure), m_size(size), m_kappa(kappa), m_a1(1), m_b1(0), m_x1(dimension, 0.0), m_D1(dimension, 1.0), m_U1(dimension), m_a2(1), m_b2(0), m_x2(dimension, 0.0), m_D2(dimension, 1.0), m_U2(dimension), m_delta(dimension, 0.0), m_s(1), m_handler(SearchPointType(dimension, -5.0), SearchPointType(dimension, 5.0)), m_rng(instance) {
+    announceConstraintHandler(&m_handler);
+    m_features |= CAN_PROPOSE_STARTING_POINT | IS_THREAD_SAFE;
+
+    if (name.size() != 3) throw runtime_error("invalid problem name: " + name);
+    unsigned int category = name[0] - '0';
+    if (category < 1 || category > 9) throw runtime_error("invalid problem name: " + name);
+    if (name[1] != '|' && name[1] != '/') throw runtime_error("invalid problem name: " + name);
+    bool aligned = (name[1] == '|');
+    if (name[2] == 'C')
+        m_s = 1.0;
+    else if (name[2] == 'I')
+        m_s = 0.5;
+    else if (name[2] == 'J')
+        m_s = 0.25;
+    else
+        throw runtime_error("invalid problem name: " + name);
+    if (size == 0) throw runtime_error("StructuredMOBenchmark needs a positive block size or number of reflectors.");
+
+    // unit vector delta in the plane of coordinates i and j
+    auto planar = [this](unsigned int i, unsigned int j, double angle) {
+        m_delta[i] = cos(angle);
+        m_delta[j] = sin(angle);
+    };
+    auto normalized = [](vector<double> v) {
+        double norm = sqrt(inner_product(v.begin(), v.end(), v.begin(), 0.0));
+        for (double& e : v) e /= norm;
+        return v;
+    };
+    auto column = [this](ImplicitRotation const& U, unsigned int p) {
+        vector<double> e(m_dimension, 0.0), ret(m_dimension);
+        e[p] = 1.0;
+        U.apply(e.data(), ret.data());
+        return ret;
+    };
+
+    // create the problem instance; U_1 = U_2 = I unless set below
+    uniform_real_distribution<double> uni(0, 1);
+    uniform_int_distribution<unsigned int> uniDim(0, m_dimension - 1);
+    if (category == 1) {
+        if (aligned)
+            m_delta[uniDim(m_rng)] = 1;
+        else
+            m_delta = normalized(gauss(m_dimension));
+    } else if (category >= 2 && category <= 4) {
+        if (aligned) {
+            if (category >= 3) m_D1 = createD();
+            if (category != 3) m_D2 = createD();
+            if (category == 3) m_D2 = m_D1;
+            m_delta[uniDim(m_rng)] = 1;
+        } else {
+            unsigned int i = uniDim(m_rng);
+            unsigned int j = uniform_int_distribution<unsigned int>(0, m_dimension - 2)(m_rng);
+            if (j >= i) j++;
+            if (category >= 3) m_D1 = createDdup(i, j);
+            if (category != 3) m_D2 = createDdup(i, j);
+            if (category == 3) m_D2 = m_D1;
+            planar(i, j, 2 * M_PI * uni(m_rng));
+        }
+    } else if (category == 5 || category == 6) {
+        m_D2 = createD();
+        if (aligned) {
+            if (category == 6) m_D1 = createD();
+            unsigned int i = uniDim(m_rng);
+            m_U2 = sampleRotation(i);
+            m_delta[i] = 1.0;
+        } else if (category == 5) {
+            // H_1 = I, so every eigenvector of H_2 qualifies
+            m_U2 = sampleRotation();
+            m_delta = column(m_U2, uniDim(m_rng));
+        } else {
+            unsigned int i = uniDim(m_rng);
+            unsigned int j = uniform_int_distribution<unsigned int>(0, m_dimension - 2)(m_rng);
+            if (j >= i) j++;
+            m_D1 = createDdup(i, j);
+            planar(i, j, 2 * M_PI * uni(m_rng));
+            m_U2 = sampleRotation();
+            m_U2.alignColumn(uniDim(m_rng), m_delta);
+        }
+    } else if (category == 7 || category == 8) {
+        m_D1 = createD();
+        m_D2 = (category == 7) ? m_D1 : createD();
+        if (aligned) {
+            unsigned int i = uniDim(m_rng);
+            m_U1 = sampleRotation(i);
+            m_delta[i] = 1.0;
+        } else {
+            m_U1 = sampleRotation();
+            m_delta = column(m_U1, uniDim(m_rng));
+        }
+        m_U2 = m_U1;
+    } else if (category == 9) {
+        m_D1 = createD();
+        m_D2 = createD();
+        m_U1 = sampleRotation();
+        m_U2 = sampleRotation();
+        if (aligned)
+            m_delta[uniDim(m_rng)] = 1.0;
+        else
+            m_delta = normalized(gauss(m_dimension));
+        m_U1.alignColumn(uniDim(m_rng), m_delta);
+        m_U2.alignColumn(uniDim(m_rng), m_delta);
+    }
+
+    // sample single-objective optima in the range [-5, 5]^n
+    auto normInf = [](vector<double> const& v) {
+        double ret = 0.0;
+        for (double e : v) ret = max(ret, fabs(e));
+        return ret;
+    };
+    vector<double> center = gauss(dimension);
+    while (normInf(center) >= 4.5) center = gauss(dimension);
+    for (unsigned int i = 0; i < m_dimension; i++) {
+        m_x1(i) = center[i] - 0.5 * m_delta[i];
+        m_x2(i) = center[i] + 0.5 * m_delta[i];
+    }
+
+    m_a1 = pow(10.0, 6 * uni(m_rng));
+    m_a2 = pow(10.0, 6 * uni(m_rng));
+    m_b1 = 2 * m_a1 * uni(m_rng) - m_a1;
+    m_b2 = 2 * m_a2 * uni(m_rng) - m_a2;
+}
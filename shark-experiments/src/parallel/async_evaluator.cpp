@@ -0,0 +1,94 @@
+/* async_evaluator.cpp
+ *
+ * DESCRIPTION
+ * One queue of submitted points and one of finished evaluations, both
+ * guarded by a single mutex; workers hold it only to move points between
+ * the queues, never during eval().
+ */
+#include "parallel/async_evaluator.h"
+
+#include <chrono>
+#include <stdexcept>
+
+using namespace shark;
+
+typedef std::chrono::steady_clock Clock;
+
+AsyncEvaluator::AsyncEvaluator(MultiObjectiveFunction const& function, std::size_t workers)
+    : m_function(function), m_threadSafe(function.isThreadSafe()), m_inFlight(0), m_busy(0.0), m_wait(0.0), m_stop(false) {
+    for (std::size_t w = 0; w < (workers ? workers : 1); w++) m_threads.emplace_back(&AsyncEvaluator::work, this);
+}
+
+AsyncEvaluator::~AsyncEvaluator() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_submitted.notify_all();
+    for (auto& thread : m_threads) thread.join();
+}
+
+void AsyncEvaluator::submit(std::size_t ticket, RealVector const& point) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(Result{ticket, point, RealVector()});
+        m_inFlight++;
+    }
+    m_submitted.notify_one();
+}
+
+AsyncEvaluator::Result AsyncEvaluator::next() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_inFlight == 0) throw std::runtime_error("AsyncEvaluator: no evaluation in flight.");
+    if (m_done.empty()) {
+        Clock::time_point start = Clock::now();
+        m_finished.wait(lock, [&] { return !m_done.empty(); });
+        m_wait += std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    Finished finished = std::move(m_done.front());
+    m_done.pop_front();
+    m_inFlight--;
+    lock.unlock();
+    if (finished.error) std::rethrow_exception(finished.error);
+    return std::move(finished.result);
+}
+
+std::size_t AsyncEvaluator::inFlight() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_inFlight;
+}
+
+double AsyncEvaluator::busySeconds() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_busy;
+}
+
+double AsyncEvaluator::waitSeconds() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_wait;
+}
+
+void AsyncEvaluator::work() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_submitted.wait(lock, [&] { return m_stop || !m_queue.empty(); });
+        if (m_stop) return;
+        Finished finished{std::move(m_queue.front()), nullptr};
+        m_queue.pop_front();
+        lock.unlock();
+        std::unique_lock<std::mutex> evalLock(m_evalMutex, std::defer_lock);
+        if (!m_threadSafe) evalLock.lock();
+        Clock::time_point start = Clock::now();
+        try {
+            finished.result.value = m_function.eval(finished.result.point);
+        } catch (...) {
+            finished.error = std::current_exception();
+        }
+        double busy = std::chrono::duration<double>(Clock::now() - start).count();
+        if (evalLock.owns_lock()) evalLock.unlock();
+        lock.lock();
+        m_busy += busy;
+        m_done.push_back(std::move(finished));
+        m_finished.notify_one();
+    }
+}
@@ -0,0 +1,96 @@
+/* evaluation_cache.cpp
+ *
+ * DESCRIPTION
+ * Seqlock protocol of EvaluationCache. Sequence number 0 marks a slot that
+ * was never written; a writer moves it from an even s to s + 1 by CAS,
+ * writes hash, key and value, and publishes s + 2.
+ */
+#include "parallel/evaluation_cache.h"
+
+#include <cstring>
+
+namespace {
+
+std::uint64_t bits(double x) {
+    std::uint64_t ret;
+    std::memcpy(&ret, &x, sizeof ret);
+    return ret;
+}
+
+double fromBits(std::uint64_t x) {
+    double ret;
+    std::memcpy(&ret, &x, sizeof ret);
+    return ret;
+}
+
+}  // namespace
+
+EvaluationCache::EvaluationCache(std::size_t capacity, std::size_t dimension, std::size_t objectives)
+    : m_dimension(dimension), m_objectives(objectives), m_sets(1), m_stride(2 + dimension + objectives) {
+    while (m_sets * WAYS < capacity) m_sets *= 2;
+    m_words.reset(new Word[m_sets * WAYS * m_stride]);
+    clear();
+}
+
+void EvaluationCache::clear() {
+    for (std::size_t i = 0; i != m_sets * WAYS * m_stride; i++) m_words[i].store(0, std::memory_order_relaxed);
+    m_hits.reset();
+    m_misses.reset();
+    m_insertions.reset();
+    m_evictions.reset();
+}
+
+// 64 bit multiply-xorshift over the words, with the splitmix64 finaliser
+std::uint64_t EvaluationCache::hash(double const* x) const {
+    std::uint64_t h = m_dimension;
+    for (std::size_t i = 0; i != m_dimension; i++) {
+        h = (h ^ bits(x[i])) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 32;
+    }
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+    return h ^ (h >> 31);
+}
+
+bool EvaluationCache::find(double const* x, double* value) const {
+    std::uint64_t h = hash(x);
+    std::size_t set = h & (m_sets - 1);
+    for (std::size_t w = 0; w != WAYS; w++) {
+        Word* s = slot(set * WAYS + w);
+        std::uint64_t sequence = s[0].load(std::memory_order_acquire);
+        if (sequence == 0 || (sequence & 1) || s[1].load(std::memory_order_relaxed) != h) continue;
+        bool equal = true;
+        for (std::size_t i = 0; i != m_dimension && equal; i++) equal = s[2 + i].load(std::memory_order_relaxed) == bits(x[i]);
+        if (!equal) continue;
+        for (std::size_t k = 0; k != m_objectives; k++) value[k] = fromBits(s[2 + m_dimension + k].load(std::memory_order_relaxed));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (s[0].load(std::memory_order_relaxed) != sequence) continue;
+        m_hits.increment();
+        return true;
+    }
+    m_misses.increment();
+    return false;
+}
+
+void EvaluationCache::insert(double const* x, double const* value) {
+    std::uint64_t h = hash(x);
+    std::size_t set = h & (m_sets - 1);
+    // a never used slot of the set, else a victim picked by the upper hash bits
+    std::size_t target = (h >> 32) % WAYS;
+    for (std::size_t w = 0; w != WAYS; w++) {
+        if (slot(set * WAYS + w)[0].load(std::memory_order_relaxed) == 0) {
+            target = w;
+            break;
+        }
+    }
+    Word* s = slot(set * WAYS + target);
+    std::uint64_t sequence = s[0].load(std::memory_order_relaxed);
+    if ((sequence & 1) || !s[0].compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) return;
+    std::atomic_thread_fence(std::memory_order_release);
+    s[1].store(h, std::memory_order_relaxed);
+    for (std::size_t i = 0; i != m_dimension; i++) s[2 + i].store(bits(x[i]), std::memory_order_relaxed);
+    for (std::size_t k = 0; k != m_objectives; k++) s[2 + m_dimension + k].store(bits(value[k]), std::memory_order_relaxed);
+    s[0].store(sequence + 2, std::memory_order_release);
+    m_insertions.increment();
+    if (sequence != 0) m_evictions.increment();
+}
@@ -0,0 +1,137 @@
+/* fork_branches.cpp
+ *
+ * DESCRIPTION
+ * The parent keeps up to `parallel` children alive and poll()s their pipes,
+ * so a child whose report exceeds the pipe buffer never blocks on a parent
+ * that waits for another child. A child is reaped once its pipe reaches
+ * end of file; the next branch is forked in its place.
+ */
+#include "parallel/fork_branches.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+struct Child {
+    std::size_t branch;
+    pid_t pid;
+    int fd;
+};
+
+bool writeAll(int fd, char const* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+[[noreturn]] void runChild(std::size_t i, std::function<void(std::size_t, std::ostream&)> const& branch, int fd) {
+    int status = 0;
+    try {
+        std::ostringstream report;
+        branch(i, report);
+        std::string bytes = report.str();
+        if (!writeAll(fd, bytes.data(), bytes.size())) {
+            std::cerr << "Branch " << i << ": failed to send its report" << std::endl;
+            status = 1;
+        }
+    } catch (std::exception const& e) {
+        std::cerr << "Branch " << i << ": " << e.what() << std::endl;
+        status = 1;
+    } catch (...) {
+        std::cerr << "Branch " << i << ": unknown exception" << std::endl;
+        status = 1;
+    }
+    std::cout.flush();
+    std::fflush(nullptr);
+    ::_exit(status);
+}
+
+}  // namespace
+
+std::vector<std::string> forkBranches(std::size_t branches, std::function<void(std::size_t, std::ostream&)> const& branch, std::size_t parallel) {
+    if (parallel == 0) {
+        parallel = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::vector<std::string> reports(branches);
+    std::vector<std::size_t> failed;
+    std::vector<Child> children;
+    std::size_t next = 0;
+
+    while (next != branches || !children.empty()) {
+        while (next != branches && children.size() != parallel) {
+            int fds[2];
+            if (::pipe(fds) != 0) {
+                throw std::runtime_error("Failed to create a pipe for branch " + std::to_string(next));
+            }
+            std::cout.flush();
+            std::cerr.flush();
+            std::fflush(nullptr);
+            pid_t pid = ::fork();
+            if (pid < 0) {
+                ::close(fds[0]);
+                ::close(fds[1]);
+                throw std::runtime_error("Failed to fork branch " + std::to_string(next));
+            }
+            if (pid == 0) {
+                ::close(fds[0]);
+                for (auto const& child : children) ::close(child.fd);
+                runChild(next, branch, fds[1]);
+            }
+            ::close(fds[1]);
+            children.push_back(Child{next, pid, fds[0]});
+            next++;
+        }
+
+        std::vector<pollfd> polls;
+        for (auto const& child : children) polls.push_back(pollfd{child.fd, POLLIN, 0});
+        if (::poll(polls.data(), polls.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Failed to wait for the branches");
+        }
+        char buffer[1 << 16];
+        for (std::size_t c = polls.size(); c-- > 0;) {
+            if (polls[c].revents == 0) continue;
+            Child child = children[c];
+            ssize_t received = ::read(child.fd, buffer, sizeof(buffer));
+            if (received > 0) {
+                reports[child.branch].append(buffer, received);
+                continue;
+            }
+            if (received < 0 && errno == EINTR) continue;
+            // end of file or a broken pipe: the child is done
+            ::close(child.fd);
+            int status = 0;
+            while (::waitpid(child.pid, &status, 0) < 0 && errno == EINTR) {
+            }
+            if (received < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) failed.push_back(child.branch);
+            children.erase(children.begin() + c);
+        }
+    }
+
+    if (!failed.empty()) {
+        std::sort(failed.begin(), failed.end());
+        std::string list;
+        for (auto i : failed) list += (list.empty() ? "" : ", ") + std::to_string(i);
+        throw std::runtime_error("Branches failed: " + list);
+    }
+    return reports;
+}
@@ -0,0 +1,180 @@
+/* pareto_archive.cpp
+ *
+ * DESCRIPTION
+ * Queries on a version of ParetoArchive2D and the construction of the next
+ * one. In the sorted front the members a candidate dominates are the run
+ * that starts at the first member with a first objective no smaller than
+ * the candidate's and ends before the first member that is better in the
+ * second objective; the candidate takes the place of that run. splice()
+ * rebuilds the chunks that hold the run (and a neighbour if the result is
+ * small) and leaves all other chunks shared with the previous version.
+ */
+#include "parallel/pareto_archive.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <stdexcept>
+
+using namespace shark;
+
+bool ParetoArchive2D::Snapshot::dominates(double f0, double f1) const {
+    Front const& front = *m_front;
+    // the predecessor of f0 is in the last chunk that starts at or before it
+    std::size_t c = std::upper_bound(front.firsts.begin(), front.firsts.end(), f0) - front.firsts.begin();
+    if (c == 0) return false;
+    auto const& members = front.chunks[c - 1]->members;
+    auto next = std::upper_bound(members.begin(), members.end(), f0, [](double f, Member const& member) { return f < member.value[0]; });
+    return std::prev(next)->value[1] <= f1;
+}
+
+ParetoArchive2D::Snapshot::Member const& ParetoArchive2D::Snapshot::at(Front const& front, std::size_t i) {
+    std::size_t c = chunkOf(front, i);
+    return front.chunks[c]->members[i - front.offsets[c]];
+}
+
+std::size_t ParetoArchive2D::Snapshot::chunkOf(Front const& front, std::size_t i) {
+    std::size_t c = std::upper_bound(front.offsets.begin() + 1, front.offsets.end(), i) - (front.offsets.begin() + 1);
+    return std::min(c, front.chunks.size() - 1);
+}
+
+std::size_t ParetoArchive2D::Snapshot::lowerBound(Front const& front, double f0) {
+    std::size_t c = std::lower_bound(front.firsts.begin(), front.firsts.end(), f0) - front.firsts.begin();
+    if (c == 0) return 0;
+    auto const& members = front.chunks[c - 1]->members;
+    auto first = std::lower_bound(members.begin(), members.end(), f0, [](Member const& member, double f) { return member.value[0] < f; });
+    return front.offsets[c - 1] + (first - members.begin());
+}
+
+ParetoArchive2D::ParetoArchive2D(std::size_t capacity) : m_capacity(capacity), m_current(std::make_shared<Front const>()) {
+    if (capacity == 1) {
+        throw std::runtime_error("ParetoArchive2D needs a capacity of at least two, for the extreme members.");
+    }
+}
+
+ParetoArchive2D::Snapshot ParetoArchive2D::snapshot() const { return Snapshot(std::atomic_load(&m_current)); }
+
+bool ParetoArchive2D::insert(RealVector const& point, RealVector const& value) {
+    if (snapshot().dominates(value(0), value(1))) {
+        m_rejected.increment();
+        return false;
+    }
+    std::vector<Member> candidates{Member{{value(0), value(1)}, std::make_shared<Solution const>(Solution{point, value})}};
+    return insertCandidates(candidates) == 1;
+}
+
+void ParetoArchive2D::clear() {
+    std::lock_guard<std::mutex> lock(m_writer);
+    std::shared_ptr<Front> next = std::make_shared<Front>();
+    next->version = std::atomic_load(&m_current)->version + 1;
+    std::atomic_store(&m_current, std::shared_ptr<Front const>(std::move(next)));
+}
+
+std::size_t ParetoArchive2D::insertCandidates(std::vector<Member>& candidates) {
+    std::lock_guard<std::mutex> lock(m_writer);
+    // only this thread writes, so the current version cannot change under it
+    std::shared_ptr<Front> next = std::make_shared<Front>(*std::atomic_load(&m_current));
+    next->version++;
+    std::vector<Solution const*> joined;
+    for (auto const& candidate : candidates) {
+        if (merge(*next, candidate)) {
+            joined.push_back(candidate.solution.get());
+        } else {
+            m_rejected.increment();
+        }
+    }
+    if (joined.empty()) return 0;
+    prune(*next);
+
+    // a candidate may have been dominated by a later one or pruned
+    std::sort(joined.begin(), joined.end());
+    std::size_t count = 0;
+    for (auto const& chunk : next->chunks) {
+        for (auto const& member : chunk->members) count += std::binary_search(joined.begin(), joined.end(), member.solution.get());
+    }
+    m_accepted.increment(count);
+    std::atomic_store(&m_current, std::shared_ptr<Front const>(std::move(next)));
+    return count;
+}
+
+bool ParetoArchive2D::merge(Front& front, Member const& candidate) {
+    double f0 = candidate.value[0];
+    double f1 = candidate.value[1];
+    std::size_t size = front.offsets.back();
+    std::size_t first = Snapshot::lowerBound(front, f0);
+    // with an equal first objective the predecessor is the member at first
+    std::size_t next = first != size && Snapshot::at(front, first).value[0] == f0 ? first + 1 : first;
+    if (next != 0 && Snapshot::at(front, next - 1).value[1] <= f1) return false;
+    std::size_t last = first;
+    while (last != size && Snapshot::at(front, last).value[1] >= f1) last++;
+    splice(front, first, last, &candidate);
+    return true;
+}
+
+void ParetoArchive2D::splice(Front& front, std::size_t first, std::size_t last, Member const* candidate) {
+    std::size_t cf = 0, cl = 0;
+    std::vector<Member> merged;
+    if (!front.chunks.empty()) {
+        cf = Snapshot::chunkOf(front, first);
+        cl = last > first ? Snapshot::chunkOf(front, last - 1) : cf;
+        for (std::size_t c = cf; c <= cl; c++) {
+            for (std::size_t j = 0; j != front.chunks[c]->members.size(); j++) {
+                std::size_t i = front.offsets[c] + j;
+                if (i == first && candidate) merged.push_back(*candidate);
+                if (i < first || i >= last) merged.push_back(front.chunks[c]->members[j]);
+            }
+        }
+        // appended behind the last member
+        if (first == front.offsets[cl + 1] && candidate) merged.push_back(*candidate);
+        // small chunks absorb a neighbour
+        if (merged.size() < CHUNK / 2 && cl + 1 < front.chunks.size()) {
+            cl++;
+            merged.insert(merged.end(), front.chunks[cl]->members.begin(), front.chunks[cl]->members.end());
+        } else if (merged.size() < CHUNK / 2 && cf > 0) {
+            cf--;
+            merged.insert(merged.begin(), front.chunks[cf]->members.begin(), front.chunks[cf]->members.end());
+        }
+        front.chunks.erase(front.chunks.begin() + cf, front.chunks.begin() + cl + 1);
+    } else if (candidate) {
+        merged.push_back(*candidate);
+    }
+
+    // pieces of CHUNK to 2 * CHUNK members, unless there are fewer
+    std::size_t pieces = merged.size() > 2 * CHUNK ? merged.size() / CHUNK : !merged.empty();
+    std::vector<std::shared_ptr<Chunk const>> chunks;
+    for (std::size_t p = 0; p != pieces; p++) {
+        std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>();
+        chunk->members.assign(merged.begin() + merged.size() * p / pieces, merged.begin() + merged.size() * (p + 1) / pieces);
+        chunks.push_back(std::move(chunk));
+    }
+    front.chunks.insert(front.chunks.begin() + cf, chunks.begin(), chunks.end());
+
+    front.firsts.resize(front.chunks.size());
+    front.offsets.resize(front.chunks.size() + 1);
+    for (std::size_t c = 0; c != front.chunks.size(); c++) {
+        front.firsts[c] = front.chunks[c]->members.front().value[0];
+        front.offsets[c + 1] = front.offsets[c] + front.chunks[c]->members.size();
+    }
+}
+
+void ParetoArchive2D::prune(Front& front) {
+    if (m_capacity == 0) return;
+    while (front.offsets.back() > m_capacity) {
+        m_values.clear();
+        for (auto const& chunk : front.chunks) {
+            for (auto const& member : chunk->members) m_values.insert(m_values.end(), member.value, member.value + 2);
+        }
+        std::size_t size = m_values.size() / 2;
+        std::size_t worst = 1;
+        double smallest = 0.0;
+        for (std::size_t i = 1; i + 1 < size; i++) {
+            double contribution = (m_values[2 * i + 2] - m_values[2 * i]) * (m_values[2 * i - 1] - m_values[2 * i + 1]);
+            if (i == 1 || contribution < smallest) {
+                smallest = contribution;
+                worst = i;
+            }
+        }
+        splice(front, worst, worst + 1, nullptr);
+        m_pruned.increment();
+    }
+}
@@ -0,0 +1,93 @@
+/* thread_pool.cpp
+ *
+ * DESCRIPTION
+ * Workers sleep on a generation counter. parallelFor() publishes the loop,
+ * bumps the generation and joins in; the last worker to run out of
+ * indices wakes the caller.
+ */
+#include "parallel/thread_pool.h"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(std::size_t threads)
+    : m_generation(0), m_active(0), m_stop(false), m_body(nullptr), m_n(0), m_chunk(1), m_next(0) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    m_workers.reserve(threads - 1);
+    for (std::size_t w = 1; w < threads; w++) {
+        m_workers.emplace_back(&ThreadPool::run, this, w);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_all();
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t n, std::function<void(std::size_t, std::size_t)> const& body, std::size_t chunk) {
+    if (n == 0) return;
+    if (m_workers.empty() || n <= chunk) {
+        for (std::size_t i = 0; i != n; i++) body(i, 0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_body = &body;
+        m_n = n;
+        m_chunk = std::max<std::size_t>(1, chunk);
+        m_next.store(0, std::memory_order_relaxed);
+        m_error = nullptr;
+        m_active = size();
+        m_generation++;
+    }
+    m_start.notify_all();
+    work(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finish.wait(lock, [this] { return m_active == 0; });
+    m_body = nullptr;
+    if (m_error) {
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::run(std::size_t worker) {
+    std::uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop) return;
+            seen = m_generation;
+        }
+        work(worker);
+    }
+}
+
+void ThreadPool::work(std::size_t worker) {
+    std::exception_ptr error;
+    while (!error) {
+        std::size_t begin = m_next.fetch_add(m_chunk, std::memory_order_relaxed);
+        if (begin >= m_n) break;
+        std::size_t end = std::min(m_n, begin + m_chunk);
+        try {
+            for (std::size_t i = begin; i != end; i++) (*m_body)(i, worker);
+        } catch (...) {
+            error = std::current_exception();
+            // let the other workers run dry
+            m_next.store(m_n, std::memory_order_relaxed);
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (error && !m_error) m_error = error;
+    if (--m_active == 0) m_finish.notify_one();
+}
@@ -0,0 +1,156 @@
+/* plot_queue.cpp
+ *
+ * DESCRIPTION
+ * Spool directory writer for plot specs. For a spec with sequence number
+ * s written by process p two files are created:
+ *   p-s.bin   the series as raw native-endian doubles, x then y per series
+ *   p-s.spec  a line based text description, renamed into place last
+ * The worker only picks up *.spec files, so it never sees partial data.
+ */
+#include "plotting/plot_queue.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// unique across all queues of this process
+std::atomic<std::uint64_t> s_sequence(0);
+
+// keep titles on a single line of the spec file
+std::string escape(std::string const& text) {
+    std::string ret;
+    for (char c : text) {
+        if (c == '\\') {
+            ret += "\\\\";
+        } else if (c == '\n') {
+            ret += "\\n";
+        } else {
+            ret += c;
+        }
+    }
+    return ret;
+}
+
+// strided columns are gathered in chunks, contiguous ones written directly
+void writeColumn(std::ofstream& out, PlotColumn const& column) {
+    if (column.contiguous()) {
+        out.write(reinterpret_cast<char const*>(column.data()), column.size() * sizeof(double));
+        return;
+    }
+    double buffer[512];
+    for (std::size_t i = 0; i < column.size();) {
+        std::size_t n = std::min<std::size_t>(512, column.size() - i);
+        for (std::size_t j = 0; j != n; j++) {
+            buffer[j] = column[i + j];
+        }
+        out.write(reinterpret_cast<char const*>(buffer), n * sizeof(double));
+        i += n;
+    }
+}
+
+}  // namespace
+
+PlotQueue::PlotQueue(std::string const& spoolDirectory, std::size_t capacity)
+    : m_directory(spoolDirectory), m_capacity(std::max<std::size_t>(1, capacity)), m_submitted(0), m_published(0), m_stop(false) {
+    fs::create_directories(m_directory);
+    m_writer = std::thread(&PlotQueue::run, this);
+}
+
+PlotQueue::~PlotQueue() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_work.notify_all();
+    m_writer.join();
+}
+
+void PlotQueue::submit(PlotSpec spec) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_pending.size() < m_capacity || m_error; });
+    if (m_error) std::rethrow_exception(m_error);
+    m_pending.push_back(std::move(spec));
+    m_submitted++;
+    lock.unlock();
+    m_work.notify_one();
+}
+
+void PlotQueue::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_published == m_submitted || m_error; });
+    if (m_error) std::rethrow_exception(m_error);
+}
+
+void PlotQueue::run() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_work.wait(lock, [this] { return m_stop || !m_pending.empty(); });
+        if (m_pending.empty()) return;
+        PlotSpec spec = std::move(m_pending.front());
+        m_pending.pop_front();
+        lock.unlock();
+        try {
+            publish(spec);
+        } catch (...) {
+            lock.lock();
+            m_error = std::current_exception();
+            m_pending.clear();
+            m_done.notify_all();
+            return;
+        }
+        lock.lock();
+        m_published++;
+        m_done.notify_all();
+    }
+}
+
+void PlotQueue::publish(PlotSpec const& spec) {
+    std::string stem = std::to_string(::getpid()) + "-" + std::to_string(s_sequence++);
+    fs::path data = fs::path(m_directory) / (stem + ".bin");
+    fs::path text = fs::path(m_directory) / (stem + ".spec");
+    fs::path partial = fs::path(m_directory) / (stem + ".spec.tmp");
+
+    std::ofstream out(data, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to open file: " + data.string());
+    }
+    for (auto const& series : spec.series) {
+        if (series.x.size() != series.y.size()) {
+            throw std::runtime_error("Plot series have different lengths.");
+        }
+        writeColumn(out, series.x);
+        writeColumn(out, series.y);
+    }
+    out.close();
+    // a short data file must not be published with a valid spec
+    if (!out) {
+        throw std::runtime_error("Failed to write file: " + data.string());
+    }
+
+    out.open(partial, std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to open file: " + partial.string());
+    }
+    out << "version 1\n";
+    out << "size " << spec.width << " " << spec.height << "\n";
+    out << "title " << escape(spec.title) << "\n";
+    // the worker does not share our working directory
+    out << "output " << fs::absolute(spec.filename).string() << "\n";
+    out << "data " << data.filename().string() << "\n";
+    for (auto const& series : spec.series) {
+        out << "series " << series.x.size() << " " << series.format << "\n";
+    }
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Failed to write file: " + partial.string());
+    }
+    fs::rename(partial, text);
+}
@@ -0,0 +1,716 @@
+/* raster.cpp
+ *
+ * DESCRIPTION
+ * Native rasteriser and PNG/SVG writers for PlotSpec figures. The PNG
+ * encoder emits a single fixed-Huffman deflate block whose matches only
+ * repeat the previous byte or pixel. Plots are mostly background, so this
+ * gets most of what zlib would at a fraction of the cost and without the
+ * dependency.
+ */
+#include "plotting/raster.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+struct Style {
+    RGBA color;
+    char marker;
+    bool line;
+    bool dashed;
+};
+
+Style parseFormat(std::string const& format) {
+    Style style{RGBA{31, 119, 180, 255}, 0, false, false};
+    for (std::size_t i = 0; i < format.size(); i++) {
+        char c = format[i];
+        switch (c) {
+            case 'b': style.color = RGBA{0, 0, 255, 255}; break;
+            case 'g': style.color = RGBA{0, 128, 0, 255}; break;
+            case 'r': style.color = RGBA{255, 0, 0, 255}; break;
+            case 'c': style.color = RGBA{0, 191, 191, 255}; break;
+            case 'm': style.color = RGBA{191, 0, 191, 255}; break;
+            case 'y': style.color = RGBA{191, 191, 0, 255}; break;
+            case 'k': style.color = RGBA{0, 0, 0, 255}; break;
+            case 'w': style.color = RGBA{255, 255, 255, 255}; break;
+            case 'x':
+            case '+':
+            case 'o':
+            case '.':
+            case ',':
+            case 's': style.marker = c; break;
+            case '-':
+                style.line = true;
+                if (i + 1 < format.size() && format[i + 1] == '-') {
+                    style.dashed = true;
+                    i++;
+                }
+                break;
+            default:
+                throw std::runtime_error("Unsupported plot format: " + format);
+        }
+    }
+    // like matplotlib, a format without marker and line style is a line
+    if (!style.marker && !style.line) style.line = true;
+    return style;
+}
+
+struct Axis {
+    double lo;
+    double hi;
+    std::vector<double> ticks;
+};
+
+Axis makeAxis(double lo, double hi) {
+    if (!(lo <= hi)) {
+        lo = 0.0;
+        hi = 1.0;
+    } else if (lo == hi) {
+        double pad = lo == 0.0 ? 0.5 : 0.05 * std::abs(lo);
+        lo -= pad;
+        hi += pad;
+    }
+    double margin = 0.05 * (hi - lo);
+    Axis axis{lo - margin, hi + margin, {}};
+
+    double raw = (axis.hi - axis.lo) / 5.0;
+    double magnitude = std::pow(10.0, std::floor(std::log10(raw)));
+    double normalized = raw / magnitude;
+    double step = (normalized < 1.5 ? 1.0 : normalized < 3.0 ? 2.0 : normalized < 7.0 ? 5.0 : 10.0) * magnitude;
+    for (double t = std::ceil(axis.lo / step) * step; t <= axis.hi; t += step) {
+        // avoid labels like "-1.4e-17"
+        axis.ticks.push_back(std::abs(t) < 1e-9 * step ? 0.0 : t);
+    }
+    return axis;
+}
+
+struct Layout {
+    long width;
+    long height;
+    long left = 70;
+    long right = 20;
+    long top = 40;
+    long bottom = 30;
+    Axis x;
+    Axis y;
+
+    double px(double v) const { return left + (v - x.lo) / (x.hi - x.lo) * (width - left - right); }
+    double py(double v) const { return height - bottom - (v - y.lo) / (y.hi - y.lo) * (height - top - bottom); }
+};
+
+Layout makeLayout(PlotSpec const& spec) {
+    double xlo = INFINITY, xhi = -INFINITY, ylo = INFINITY, yhi = -INFINITY;
+    for (auto const& series : spec.series) {
+        for (std::size_t i = 0; i < series.x.size() && i < series.y.size(); i++) {
+            if (!std::isfinite(series.x[i]) || !std::isfinite(series.y[i])) continue;
+            xlo = std::min(xlo, series.x[i]);
+            xhi = std::max(xhi, series.x[i]);
+            ylo = std::min(ylo, series.y[i]);
+            yhi = std::max(yhi, series.y[i]);
+        }
+    }
+    Layout layout;
+    layout.width = spec.width;
+    layout.height = spec.height;
+    layout.x = makeAxis(xlo, xhi);
+    layout.y = makeAxis(ylo, yhi);
+    return layout;
+}
+
+std::string tickLabel(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.3g", value);
+    return buffer;
+}
+
+std::vector<std::string> lines(std::string const& text) {
+    std::vector<std::string> ret(1);
+    for (char c : text) {
+        if (c == '\n') {
+            ret.emplace_back();
+        } else {
+            ret.back() += c;
+        }
+    }
+    return ret;
+}
+
+// 3x5 glyphs, one bit per pixel, rows from top to bottom
+std::uint16_t glyph(char c) {
+    if (c >= 'a' && c <= 'z') c = c - 'a' + 'A';
+    switch (c) {
+        case '0': return 0b111'101'101'101'111;
+        case '1': return 0b010'110'010'010'111;
+        case '2': return 0b111'001'111'100'111;
+        case '3': return 0b111'001'111'001'111;
+        case '4': return 0b101'101'111'001'001;
+        case '5': return 0b111'100'111'001'111;
+        case '6': return 0b111'100'111'101'111;
+        case '7': return 0b111'001'001'001'001;
+        case '8': return 0b111'101'111'101'111;
+        case '9': return 0b111'101'111'001'111;
+        case 'A': return 0b010'101'111'101'101;
+        case 'B': return 0b110'101'110'101'110;
+        case 'C': return 0b011'100'100'100'011;
+        case 'D': return 0b110'101'101'101'110;
+        case 'E': return 0b111'100'110'100'111;
+        case 'F': return 0b111'100'110'100'100;
+        case 'G': return 0b011'100'101'101'011;
+        case 'H': return 0b101'101'111'101'101;
+        case 'I': return 0b111'010'010'010'111;
+        case 'J': return 0b001'001'001'101'010;
+        case 'K': return 0b101'101'110'101'101;
+        case 'L': return 0b100'100'100'100'111;
+        case 'M': return 0b101'111'111'101'101;
+        case 'N': return 0b110'101'101'101'101;
+        case 'O': return 0b010'101'101'101'010;
+        case 'P': return 0b110'101'110'100'100;
+        case 'Q': return 0b010'101'101'110'011;
+        case 'R': return 0b110'101'110'101'101;
+        case 'S': return 0b011'100'010'001'110;
+        case 'T': return 0b111'010'010'010'010;
+        case 'U': return 0b101'101'101'101'111;
+        case 'V': return 0b101'101'101'101'010;
+        case 'W': return 0b101'101'111'111'101;
+        case 'X': return 0b101'101'010'101'101;
+        case 'Y': return 0b101'101'010'010'010;
+        case 'Z': return 0b111'001'010'100'111;
+        case '-': return 0b000'000'111'000'000;
+        case '.': return 0b000'000'000'000'010;
+        case ',': return 0b000'000'000'010'100;
+        case '=': return 0b000'111'000'111'000;
+        case '(': return 0b001'010'010'010'001;
+        case ')': return 0b100'010'010'010'100;
+        case '+': return 0b000'010'111'010'000;
+        case '|': return 0b010'010'010'010'010;
+        case '/': return 0b001'001'010'100'100;
+        case ':': return 0b000'010'000'010'000;
+        case '_': return 0b000'000'000'000'111;
+        default: return 0;
+    }
+}
+
+constexpr RGBA BLACK{0, 0, 0, 255};
+
+// deflate bit stream, least significant bit first
+class BitWriter {
+   public:
+    explicit BitWriter(std::vector<std::uint8_t>& out) : m_out(out), m_buffer(0), m_count(0) {}
+
+    void bits(std::uint32_t value, unsigned int count) {
+        m_buffer |= static_cast<std::uint64_t>(value) << m_count;
+        m_count += count;
+        if (m_count >= 32) {
+            std::uint8_t const bytes[4] = {static_cast<std::uint8_t>(m_buffer), static_cast<std::uint8_t>(m_buffer >> 8), static_cast<std::uint8_t>(m_buffer >> 16), static_cast<std::uint8_t>(m_buffer >> 24)};
+            m_out.insert(m_out.end(), bytes, bytes + 4);
+            m_buffer >>= 32;
+            m_count -= 32;
+        }
+    }
+
+    void flush() {
+        for (; m_count > 0; m_count -= std::min(m_count, 8u)) {
+            m_out.push_back(static_cast<std::uint8_t>(m_buffer));
+            m_buffer >>= 8;
+        }
+        m_buffer = 0;
+    }
+
+   private:
+    std::vector<std::uint8_t>& m_out;
+    std::uint64_t m_buffer;
+    unsigned int m_count;
+};
+
+// fixed Huffman code of every literal/length symbol, already bit reversed
+struct Code {
+    std::uint16_t bits;
+    std::uint8_t length;
+};
+
+std::array<Code, 288> const& literalCodes() {
+    static std::array<Code, 288> const table = [] {
+        std::array<Code, 288> t{};
+        for (unsigned int value = 0; value < 288; value++) {
+            std::uint32_t code;
+            unsigned int length;
+            if (value < 144) {
+                code = 0x30 + value;
+                length = 8;
+            } else if (value < 256) {
+                code = 0x190 + value - 144;
+                length = 9;
+            } else if (value < 280) {
+                code = value - 256;
+                length = 7;
+            } else {
+                code = 0xc0 + value - 280;
+                length = 8;
+            }
+            std::uint32_t reversed = 0;
+            for (unsigned int i = 0; i < length; i++) reversed |= ((code >> i) & 1u) << (length - 1 - i);
+            t[value] = Code{static_cast<std::uint16_t>(reversed), static_cast<std::uint8_t>(length)};
+        }
+        return t;
+    }();
+    return table;
+}
+
+void literal(BitWriter& writer, unsigned int value) {
+    Code const& code = literalCodes()[value];
+    writer.bits(code.bits, code.length);
+}
+
+// number of equal bytes of a and b, at most limit
+std::size_t common(std::uint8_t const* a, std::uint8_t const* b, std::size_t limit) {
+    std::size_t length = 0;
+    while (length + 8 <= limit) {
+        std::uint64_t x, y;
+        std::memcpy(&x, a + length, 8);
+        std::memcpy(&y, b + length, 8);
+        if (x != y) break;
+        length += 8;
+    }
+    while (length < limit && a[length] == b[length]) length++;
+    return length;
+}
+
+void match(BitWriter& writer, unsigned int length, unsigned int distanceCode) {
+    static constexpr std::array<unsigned int, 29> base = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    static constexpr std::array<unsigned int, 29> extra = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    std::size_t i = std::upper_bound(base.begin(), base.end(), length) - base.begin() - 1;
+    literal(writer, 257 + i);
+    writer.bits(length - base[i], extra[i]);
+    // 5 bit distance code, bit reversed
+    std::uint32_t reversed = 0;
+    for (unsigned int b = 0; b < 5; b++) reversed |= ((distanceCode >> b) & 1u) << (4 - b);
+    writer.bits(reversed, 5);
+}
+
+// zlib stream with one fixed-Huffman block using distance 1 and 4 matches,
+// fed one scanline at a time (matches do not cross scanlines)
+class Deflater {
+   public:
+    explicit Deflater(std::vector<std::uint8_t>& out) : m_out(out), m_writer(out), m_a(1), m_b(0) {
+        m_out.push_back(0x78);
+        m_out.push_back(0x01);
+        m_writer.bits(1, 1);  // final block
+        m_writer.bits(1, 2);  // fixed Huffman codes
+    }
+
+    void write(std::uint8_t const* data, std::size_t n) {
+        std::size_t i = 0;
+        while (i < n) {
+            std::size_t limit = std::min<std::size_t>(258, n - i);
+            std::size_t best = 0;
+            unsigned int bestCode = 0;
+            // distance codes 0 and 3 stand for distances 1 and 4
+            for (unsigned int distanceCode : {3u, 0u}) {
+                std::size_t distance = distanceCode + 1;
+                if (i < distance || best == limit) continue;
+                std::size_t length = common(data + i, data + i - distance, limit);
+                if (length > best) {
+                    best = length;
+                    bestCode = distanceCode;
+                }
+            }
+            if (best >= 3) {
+                match(m_writer, best, bestCode);
+                i += best;
+            } else {
+                literal(m_writer, data[i]);
+                i++;
+            }
+        }
+        checksum(data, n);
+    }
+
+    // append count zero bytes following a non-zero byte
+    void zeros(std::size_t count) {
+        std::size_t total = count;
+        if (count > 0) {
+            literal(m_writer, 0);
+            count--;
+        }
+        while (count >= 3) {
+            std::size_t length = std::min<std::size_t>(258, count);
+            // never leave a remainder too short for a match
+            if (count - length > 0 && count - length < 3) length -= 3;
+            match(m_writer, length, 0);
+            count -= length;
+        }
+        while (count-- > 0) literal(m_writer, 0);
+        // zeros leave a unchanged and add a to b once per byte
+        m_b = (m_b + static_cast<std::uint64_t>(m_a) * (total % 65521)) % 65521;
+    }
+
+    void finish() {
+        literal(m_writer, 256);
+        m_writer.flush();
+        std::uint32_t adler = (m_b << 16) | m_a;
+        for (int shift = 24; shift >= 0; shift -= 8) m_out.push_back(static_cast<std::uint8_t>(adler >> shift));
+    }
+
+   private:
+    // Adler-32 over blocks small enough for 32 bit partial sums, in a form
+    // the compiler can vectorise
+    void checksum(std::uint8_t const* data, std::size_t n) {
+        while (n > 0) {
+            std::uint32_t block = std::min<std::size_t>(n, 256);
+            std::uint32_t sum = 0, weighted = 0;
+            for (std::uint32_t k = 0; k < block; k++) {
+                sum += data[k];
+                weighted += (block - k) * data[k];
+            }
+            m_b = (m_b + static_cast<std::uint64_t>(block) * m_a + weighted) % 65521;
+            m_a = (m_a + sum) % 65521;
+            data += block;
+            n -= block;
+        }
+    }
+
+    std::vector<std::uint8_t>& m_out;
+    BitWriter m_writer;
+    std::uint32_t m_a;
+    std::uint32_t m_b;
+};
+
+std::uint32_t crc32(std::uint8_t const* data, std::size_t size, std::uint32_t crc = 0) {
+    static std::array<std::uint32_t, 256> const table = [] {
+        std::array<std::uint32_t, 256> t{};
+        for (std::uint32_t i = 0; i < 256; i++) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+void chunk(std::ofstream& out, char const* type, std::vector<std::uint8_t> const& payload) {
+    std::uint8_t header[8];
+    std::uint32_t length = payload.size();
+    for (int k = 0; k < 4; k++) header[k] = static_cast<std::uint8_t>(length >> (24 - 8 * k));
+    std::copy(type, type + 4, header + 4);
+    std::uint32_t crc = crc32(header + 4, 4);
+    crc = crc32(payload.data(), payload.size(), crc);
+    std::uint8_t trailer[4];
+    for (int k = 0; k < 4; k++) trailer[k] = static_cast<std::uint8_t>(crc >> (24 - 8 * k));
+    out.write(reinterpret_cast<char const*>(header), 8);
+    out.write(reinterpret_cast<char const*>(payload.data()), payload.size());
+    out.write(reinterpret_cast<char const*>(trailer), 4);
+}
+
+std::string hex(RGBA color) {
+    char buffer[8];
+    std::snprintf(buffer, sizeof(buffer), "#%02x%02x%02x", color.r, color.g, color.b);
+    return buffer;
+}
+
+std::string escapeXML(std::string const& text) {
+    std::string ret;
+    for (char c : text) {
+        switch (c) {
+            case '&': ret += "&amp;"; break;
+            case '<': ret += "&lt;"; break;
+            case '>': ret += "&gt;"; break;
+            case '"': ret += "&quot;"; break;
+            default: ret += c;
+        }
+    }
+    return ret;
+}
+
+}  // namespace
+
+RasterCanvas::RasterCanvas(std::size_t width, std::size_t height, RGBA background)
+    : m_width(width), m_height(height), m_pixels(4 * width * height) {
+    clear(background);
+}
+
+void RasterCanvas::clear(RGBA color) {
+    if (m_pixels.empty()) return;
+    std::uint8_t const pattern[4] = {color.r, color.g, color.b, color.a};
+    std::memcpy(m_pixels.data(), pattern, 4);
+    // double the initialised prefix until the buffer is full
+    for (std::size_t filled = 4; filled < m_pixels.size(); filled *= 2) {
+        std::memcpy(m_pixels.data() + filled, m_pixels.data(), std::min(filled, m_pixels.size() - filled));
+    }
+}
+
+void RasterCanvas::pixel(long x, long y, RGBA color) {
+    if (x < 0 || y < 0 || x >= static_cast<long>(m_width) || y >= static_cast<long>(m_height)) return;
+    std::uint8_t* p = &m_pixels[4 * (y * m_width + x)];
+    p[0] = color.r;
+    p[1] = color.g;
+    p[2] = color.b;
+    p[3] = color.a;
+}
+
+void RasterCanvas::fill(long x0, long y0, long x1, long y1, RGBA color) {
+    for (long y = std::max(0L, y0); y <= std::min<long>(y1, m_height - 1); y++)
+        for (long x = std::max(0L, x0); x <= std::min<long>(x1, m_width - 1); x++)
+            pixel(x, y, color);
+}
+
+void RasterCanvas::line(long x0, long y0, long x1, long y1, RGBA color, unsigned int dash) {
+    // Bresenham
+    long dx = std::abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    long dy = -std::abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    long err = dx + dy;
+    for (unsigned long step = 0;; step++) {
+        if (dash == 0 || (step / dash) % 2 == 0) pixel(x0, y0, color);
+        if (x0 == x1 && y0 == y1) break;
+        long e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void RasterCanvas::marker(char shape, long x, long y, long radius, RGBA color) {
+    switch (shape) {
+        case 'x':
+            line(x - radius, y - radius, x + radius, y + radius, color);
+            line(x - radius, y + radius, x + radius, y - radius, color);
+            break;
+        case '+':
+            line(x - radius, y, x + radius, y, color);
+            line(x, y - radius, x, y + radius, color);
+            break;
+        case 'o':
+            for (long i = -radius; i <= radius; i++) {
+                for (long j = -radius; j <= radius; j++) {
+                    long d = i * i + j * j;
+                    if (d <= radius * radius && d > (radius - 1) * (radius - 1)) pixel(x + i, y + j, color);
+                }
+            }
+            break;
+        case '.':
+            fill(x - 1, y - 1, x + 1, y + 1, color);
+            break;
+        case ',':
+            pixel(x, y, color);
+            break;
+        case 's':
+            fill(x - radius, y - radius, x + radius, y + radius, color);
+            break;
+    }
+}
+
+void RasterCanvas::text(std::string const& text, long x, long y, RGBA color, long scale) {
+    long cx = x;
+    for (char c : text) {
+        if (c == '\n') {
+            cx = x;
+            y += 7 * scale;
+            continue;
+        }
+        std::uint16_t g = glyph(c);
+        for (int row = 0; row < 5; row++)
+            for (int col = 0; col < 3; col++)
+                if (g & (1u << (14 - 3 * row - col)))
+                    fill(cx + col * scale, y + row * scale, cx + (col + 1) * scale - 1, y + (row + 1) * scale - 1, color);
+        cx += 4 * scale;
+    }
+}
+
+long RasterCanvas::textWidth(std::string const& text, long scale) {
+    return text.empty() ? 0 : (4 * static_cast<long>(text.size()) - 1) * scale;
+}
+
+void RasterCanvas::writePNG(std::string const& filename) const {
+    // Every scanline is stored with the "up" filter, so pixels equal to the
+    // ones above become zeros and repeated scanlines are a single run.
+    std::size_t stride = 4 * m_width;
+    std::vector<std::uint8_t> idat;
+    idat.reserve(stride + 64);
+    Deflater deflater(idat);
+    std::vector<std::uint8_t> row(stride + 1);
+    row[0] = 2;
+    for (std::size_t y = 0; y < m_height; y++) {
+        std::uint8_t const* current = &m_pixels[y * stride];
+        if (y == 0) {
+            std::memcpy(row.data() + 1, current, stride);
+        } else if (std::memcmp(current, current - stride, stride) == 0) {
+            deflater.write(row.data(), 1);
+            deflater.zeros(stride);
+            continue;
+        } else {
+            for (std::size_t i = 0; i < stride; i++) row[i + 1] = current[i] - current[i - stride];
+        }
+        deflater.write(row.data(), row.size());
+    }
+    deflater.finish();
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+    static std::uint8_t const signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    out.write(reinterpret_cast<char const*>(signature), 8);
+    std::vector<std::uint8_t> header(13, 0);
+    for (int k = 0; k < 4; k++) {
+        header[k] = static_cast<std::uint8_t>(m_width >> (24 - 8 * k));
+        header[4 + k] = static_cast<std::uint8_t>(m_height >> (24 - 8 * k));
+    }
+    header[8] = 8;  // bit depth
+    header[9] = 6;  // RGBA
+    chunk(out, "IHDR", header);
+    chunk(out, "IDAT", idat);
+    chunk(out, "IEND", {});
+    if (!out) {
+        throw std::runtime_error("Failed to write file: " + filename);
+    }
+}
+
+RasterCanvas rasterize(PlotSpec const& spec) {
+    Layout layout = makeLayout(spec);
+    RasterCanvas canvas(spec.width, spec.height);
+    long x0 = layout.left, x1 = spec.width - layout.right;
+    long y0 = layout.top, y1 = spec.height - layout.bottom;
+
+    for (auto const& series : spec.series) {
+        Style style = parseFormat(series.format);
+        bool previous = false;
+        long px = 0, py = 0;
+        for (std::size_t i = 0; i < series.x.size() && i < series.y.size(); i++) {
+            if (!std::isfinite(series.x[i]) || !std::isfinite(series.y[i])) {
+                previous = false;
+                continue;
+            }
+            long qx = std::lround(layout.px(series.x[i]));
+            long qy = std::lround(layout.py(series.y[i]));
+            if (style.line && previous) canvas.line(px, py, qx, qy, style.color, style.dashed ? 4 : 0);
+            if (style.marker) canvas.marker(style.marker, qx, qy, 3, style.color);
+            previous = true;
+            px = qx;
+            py = qy;
+        }
+    }
+
+    // frame, ticks and labels are drawn on top of the data
+    canvas.line(x0, y0, x1, y0, BLACK);
+    canvas.line(x0, y1, x1, y1, BLACK);
+    canvas.line(x0, y0, x0, y1, BLACK);
+    canvas.line(x1, y0, x1, y1, BLACK);
+    for (double t : layout.x.ticks) {
+        long x = std::lround(layout.px(t));
+        canvas.line(x, y1, x, y1 + 4, BLACK);
+        std::string label = tickLabel(t);
+        canvas.text(label, x - RasterCanvas::textWidth(label) / 2, y1 + 8, BLACK);
+    }
+    for (double t : layout.y.ticks) {
+        long y = std::lround(layout.py(t));
+        canvas.line(x0 - 4, y, x0, y, BLACK);
+        std::string label = tickLabel(t);
+        canvas.text(label, x0 - 7 - RasterCanvas::textWidth(label), y - 2, BLACK);
+    }
+    long ty = 6;
+    for (auto const& line : lines(spec.title)) {
+        canvas.text(line, (spec.width - RasterCanvas::textWidth(line, 2)) / 2, ty, BLACK, 2);
+        ty += 14;
+    }
+    return canvas;
+}
+
+void writeSVG(PlotSpec const& spec, std::string const& filename) {
+    Layout layout = makeLayout(spec);
+    std::ofstream out(filename, std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+    long x0 = layout.left, x1 = spec.width - layout.right;
+    long y0 = layout.top, y1 = spec.height - layout.bottom;
+    out << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << spec.width << "\" height=\"" << spec.height << "\" font-family=\"sans-serif\" font-size=\"10\">\n";
+    out << "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+
+    char buffer[64];
+    auto point = [&](double x, double y) {
+        std::snprintf(buffer, sizeof(buffer), "%.2f,%.2f", layout.px(x), layout.py(y));
+        return std::string(buffer);
+    };
+    for (auto const& series : spec.series) {
+        Style style = parseFormat(series.format);
+        std::string color = hex(style.color);
+        if (style.line) {
+            out << "<polyline fill=\"none\" stroke=\"" << color << "\"" << (style.dashed ? " stroke-dasharray=\"4\"" : "") << " points=\"";
+            for (std::size_t i = 0; i < series.x.size() && i < series.y.size(); i++) {
+                if (std::isfinite(series.x[i]) && std::isfinite(series.y[i])) out << point(series.x[i], series.y[i]) << " ";
+            }
+            out << "\"/>\n";
+        }
+        if (!style.marker) continue;
+        out << "<g fill=\"" << (style.marker == 'x' || style.marker == '+' || style.marker == 'o' ? "none" : color) << "\" stroke=\"" << color << "\">\n";
+        for (std::size_t i = 0; i < series.x.size() && i < series.y.size(); i++) {
+            if (!std::isfinite(series.x[i]) || !std::isfinite(series.y[i])) continue;
+            double x = layout.px(series.x[i]), y = layout.py(series.y[i]);
+            switch (style.marker) {
+                case 'x':
+                    std::snprintf(buffer, sizeof(buffer), "<path d=\"M%.2f %.2fl6 6m0 -6l-6 6\"/>\n", x - 3, y - 3);
+                    break;
+                case '+':
+                    std::snprintf(buffer, sizeof(buffer), "<path d=\"M%.2f %.2fh6m-3 -3v6\"/>\n", x - 3, y);
+                    break;
+                case 'o':
+                    std::snprintf(buffer, sizeof(buffer), "<circle cx=\"%.2f\" cy=\"%.2f\" r=\"3\"/>\n", x, y);
+                    break;
+                case '.':
+                    std::snprintf(buffer, sizeof(buffer), "<circle cx=\"%.2f\" cy=\"%.2f\" r=\"1.5\"/>\n", x, y);
+                    break;
+                case ',':
+                    std::snprintf(buffer, sizeof(buffer), "<rect x=\"%.2f\" y=\"%.2f\" width=\"1\" height=\"1\"/>\n", x, y);
+                    break;
+                case 's':
+                    std::snprintf(buffer, sizeof(buffer), "<rect x=\"%.2f\" y=\"%.2f\" width=\"6\" height=\"6\"/>\n", x - 3, y - 3);
+                    break;
+            }
+            out << buffer;
+        }
+        out << "</g>\n";
+    }
+
+    out << "<rect x=\"" << x0 << "\" y=\"" << y0 << "\" width=\"" << x1 - x0 << "\" height=\"" << y1 - y0 << "\" fill=\"none\" stroke=\"black\"/>\n";
+    for (double t : layout.x.ticks) {
+        double x = layout.px(t);
+        out << "<line x1=\"" << x << "\" y1=\"" << y1 << "\" x2=\"" << x << "\" y2=\"" << y1 + 4 << "\" stroke=\"black\"/>\n";
+        out << "<text x=\"" << x << "\" y=\"" << y1 + 15 << "\" text-anchor=\"middle\">" << tickLabel(t) << "</text>\n";
+    }
+    for (double t : layout.y.ticks) {
+        double y = layout.py(t);
+        out << "<line x1=\"" << x0 - 4 << "\" y1=\"" << y << "\" x2=\"" << x0 << "\" y2=\"" << y << "\" stroke=\"black\"/>\n";
+        out << "<text x=\"" << x0 - 7 << "\" y=\"" << y + 3 << "\" text-anchor=\"end\">" << tickLabel(t) << "</text>\n";
+    }
+    out << "<text x=\"" << spec.width / 2 << "\" y=\"16\" text-anchor=\"middle\" font-size=\"12\">";
+    auto titleLines = lines(spec.title);
+    for (std::size_t i = 0; i < titleLines.size(); i++) {
+        out << "<tspan x=\"" << spec.width / 2 << "\" dy=\"" << (i == 0 ? 0 : 14) << "\">" << escapeXML(titleLines[i]) << "</tspan>";
+    }
+    out << "</text>\n</svg>\n";
+    if (!out) {
+        throw std::runtime_error("Failed to write file: " + filename);
+    }
+}
+
+void renderNative(PlotSpec const& spec) {
+    auto const& name = spec.filename;
+    if (name.size() >= 4 && name.compare(name.size() - 4, 4, ".svg") == 0) {
+        writeSVG(spec, name);
+    } else {
+        rasterize(spec).writePNG(name);
+    }
+}